@@ -0,0 +1,71 @@
+/*
+* cc/bench/AllocationCounter.cpp  Copyright (C) 2026  fairybow
+*
+* You should have received a copy of the GNU General Public License along with
+* this program. If not, see <https://www.gnu.org/licenses/>.
+*
+* Updated: 2026-10-16
+*/
+
+#include "AllocationCounter.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// The basic and over-aligned forms are replaced (std::pmr's default resource
+// allocates through the aligned one); the array and nothrow forms call these
+// by default
+
+namespace
+{
+	std::atomic<std::uint64_t> allocations{ 0 };
+}
+
+std::uint64_t AllocationCounter::total()
+{
+	return allocations.load(std::memory_order_relaxed);
+}
+
+void* operator new(std::size_t size)
+{
+	allocations.fetch_add(1, std::memory_order_relaxed);
+
+	if (auto memory = std::malloc(size ? size : 1))
+		return memory;
+
+	throw std::bad_alloc{};
+}
+
+void operator delete(void* memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+	std::free(memory);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+	allocations.fetch_add(1, std::memory_order_relaxed);
+
+	auto align = static_cast<std::size_t>(alignment);
+	auto rounded = (size + align - 1) / align * align;
+
+	if (auto memory = std::aligned_alloc(align, rounded ? rounded : align))
+		return memory;
+
+	throw std::bad_alloc{};
+}
+
+void operator delete(void* memory, std::align_val_t) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept
+{
+	std::free(memory);
+}
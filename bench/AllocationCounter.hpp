@@ -0,0 +1,47 @@
+#pragma once
+
+/*
+* cc/bench/AllocationCounter.hpp  Copyright (C) 2026  fairybow
+*
+* You should have received a copy of the GNU General Public License along with
+* this program. If not, see <https://www.gnu.org/licenses/>.
+*
+* Updated: 2026-10-16
+*/
+
+#include <cstdint>
+
+/// @brief Counts calls to the global operator new, across all threads, in
+/// any executable that links AllocationCounter.cpp (which replaces it)
+namespace AllocationCounter
+{
+	/// @brief Allocations made since the program started
+	std::uint64_t total();
+
+	/// @brief Allocations made while func runs
+	template <typename FuncT>
+	std::uint64_t during(FuncT func)
+	{
+		auto before = total();
+		func();
+
+		return total() - before;
+	}
+
+	/// @brief Average allocations per call of func, over iterations calls
+	template <typename FuncT>
+	double perCall(FuncT func, int iterations = 1000)
+	{
+		auto count = during
+		(
+			[&]
+			{
+				for (auto i = 0; i < iterations; ++i)
+					func();
+			}
+		);
+
+		return static_cast<double>(count) / iterations;
+	}
+
+} // namespace AllocationCounter
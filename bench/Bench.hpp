@@ -0,0 +1,56 @@
+#pragma once
+
+/*
+* cc/bench/Bench.hpp  Copyright (C) 2026  fairybow
+*
+* You should have received a copy of the GNU General Public License along with
+* this program. If not, see <https://www.gnu.org/licenses/>.
+*
+* This file uses Qt 6. Qt is a free and open-source widget toolkit for creating
+* graphical user interfaces. For more information, visit <https://www.qt.io/>.
+*
+* Updated: 2026-10-16
+*/
+
+#include "AllocationCounter.hpp"
+
+#include <QDebug>
+#include <QTest>
+
+#include <cstddef>
+#include <type_traits>
+
+/// @brief Helpers shared by the benchmarks
+namespace Bench
+{
+	namespace Detail
+	{
+		// Results land here so the optimizer can't drop the work
+		inline volatile std::size_t sink = 0;
+
+	} // namespace Bench::Detail
+
+	/// @brief Consumes a result (a number, or anything with size() or
+	/// native())
+	template <typename T>
+	void keep(const T& value)
+	{
+		if constexpr (std::is_arithmetic_v<T>)
+			Detail::sink = Detail::sink + static_cast<std::size_t>(value);
+		else if constexpr (requires { value.native(); })
+			Detail::sink = Detail::sink + value.native().size();
+		else
+			Detail::sink = Detail::sink + static_cast<std::size_t>(value.size());
+	}
+
+	/// @brief Prints the current test function's allocations per call of func
+	template <typename FuncT>
+	void reportAllocations(FuncT func, int iterations = 1000)
+	{
+		qInfo().noquote()
+			<< QTest::currentTestFunction()
+			<< "allocations/op:"
+			<< AllocationCounter::perCall(func, iterations);
+	}
+
+} // namespace Bench
@@ -0,0 +1,101 @@
+#pragma once
+
+/*
+* cc/bench/FixtureTree.hpp  Copyright (C) 2026  fairybow
+*
+* You should have received a copy of the GNU General Public License along with
+* this program. If not, see <https://www.gnu.org/licenses/>.
+*
+* This file uses Qt 6. Qt is a free and open-source widget toolkit for creating
+* graphical user interfaces. For more information, visit <https://www.qt.io/>.
+*
+* Updated: 2026-10-16
+*/
+
+#include <QDir>
+#include <QFile>
+#include <QString>
+#include <QStringList>
+#include <QTemporaryDir>
+
+/// @brief A synthetic folder tree under a temporary directory, removed on
+/// destruction. The same shape always gives the same names, contents, and
+/// counts, so runs are comparable
+class FixtureTree
+{
+public:
+	struct Shape
+	{
+		int depth = 3;
+		int foldersPerFolder = 6;
+		int filesPerFolder = 20;
+	};
+
+	FixtureTree() : FixtureTree(Shape{}) {}
+
+	explicit FixtureTree(Shape shape)
+		: m_shape(shape)
+	{
+		if (m_directory.isValid())
+			_fill(m_directory.path(), 0);
+	}
+
+	bool isValid() const { return m_directory.isValid(); }
+	QString path() const { return m_directory.path(); }
+
+	int fileCount() const { return m_files; }
+	int folderCount() const { return m_folders; }
+
+	/// @brief Files with the given extension (every extension in EXTENSIONS
+	/// gets an equal share, give or take one per folder)
+	int fileCount(const QString& extension) const
+	{
+		auto index = EXTENSIONS.indexOf(extension);
+		if (index < 0) return 0;
+
+		auto count = m_shape.filesPerFolder / EXTENSIONS.size();
+		if (index < m_shape.filesPerFolder % EXTENSIONS.size()) ++count;
+
+		return count * (m_folders + 1);
+	}
+
+	inline static const QStringList EXTENSIONS{ "txt", "cpp", "hpp", "md" };
+
+private:
+	Shape m_shape;
+	QTemporaryDir m_directory{};
+	int m_files = 0;
+	int m_folders = 0; // Not counting the root
+
+	void _fill(const QString& folder, int depth)
+	{
+		for (auto i = 0; i < m_shape.filesPerFolder; ++i)
+		{
+			auto name = QString("file_%1.%2")
+				.arg(i, 3, 10, QChar('0'))
+				.arg(EXTENSIONS.at(i % EXTENSIONS.size()));
+
+			QFile file(folder + '/' + name);
+
+			if (file.open(QIODevice::WriteOnly))
+			{
+				file.write(name.toUtf8());
+				++m_files;
+			}
+		}
+
+		if (depth == m_shape.depth) return;
+
+		for (auto i = 0; i < m_shape.foldersPerFolder; ++i)
+		{
+			auto child = folder + QString("/folder_%1").arg(i, 2, 10, QChar('0'));
+
+			if (QDir().mkpath(child))
+			{
+				++m_folders;
+				_fill(child, depth + 1);
+			}
+		}
+	}
+
+}; // class FixtureTree
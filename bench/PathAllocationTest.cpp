@@ -0,0 +1,196 @@
+/*
+* cc/bench/PathAllocationTest.cpp  Copyright (C) 2026  fairybow
+*
+* You should have received a copy of the GNU General Public License along with
+* this program. If not, see <https://www.gnu.org/licenses/>.
+*
+* This file uses Qt 6. Qt is a free and open-source widget toolkit for creating
+* graphical user interfaces. For more information, visit <https://www.qt.io/>.
+*
+* Updated: 2026-10-16
+*/
+
+#include "AllocationCounter.hpp"
+#include "FixtureTree.hpp"
+
+#include "Path.hpp"
+
+#include <QDir>
+#include <QDirIterator>
+#include <QList>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QTest>
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <utility>
+
+/// @brief Checks that Path's moves don't allocate and that fromArgs and
+/// findIn build each Path once, without copying it afterward
+/// @details Strings here are longer than any small-string buffer, so a copy
+/// always shows up as an allocation. The list-building checks compare against
+/// the allocations of constructing the same Paths directly; a per-path copy
+/// would add at least one allocation per path, far past SLACK
+class PathAllocationTest : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void moveConstruct()
+	{
+		Path path(LONG);
+
+		auto count = AllocationCounter::during
+		(
+			[&] { Path moved(std::move(path)); }
+		);
+
+		QCOMPARE(count, std::uint64_t(0));
+	}
+
+	void moveAssign()
+	{
+		Path path(LONG);
+		Path target{};
+
+		auto count = AllocationCounter::during
+		(
+			[&] { target = std::move(path); }
+		);
+
+		QCOMPARE(count, std::uint64_t(0));
+	}
+
+	void fromStdRvalue()
+	{
+		std::filesystem::path native(LONG);
+
+		auto count = AllocationCounter::during
+		(
+			[&] { Path path(std::move(native)); }
+		);
+
+		QCOMPARE(count, std::uint64_t(0));
+	}
+
+	void toStdRvalue()
+	{
+		Path path(LONG);
+
+		auto count = AllocationCounter::during
+		(
+			[&] { auto moved = std::move(path).toStd(); }
+		);
+
+		QCOMPARE(count, std::uint64_t(0));
+	}
+
+	void appendToReservedList()
+	{
+		Path path(LONG);
+		QList<Path> paths{};
+		paths.reserve(1);
+
+		auto count = AllocationCounter::during
+		(
+			[&] { paths.append(std::move(path)); }
+		);
+
+		QCOMPARE(count, std::uint64_t(0));
+	}
+
+	void fromArgs()
+	{
+		QStringList args{};
+
+		for (auto i = 0; i < ARG_COUNT; ++i)
+			args << QString(LONG) + QString::number(i);
+
+		auto baseline = AllocationCounter::during
+		(
+			[&]
+			{
+				QList<Path> paths{};
+
+				for (auto& arg : args)
+					paths.append(Path(arg));
+			}
+		);
+
+		auto count = AllocationCounter::during
+		(
+			[&]
+			{
+				auto paths = Path::fromArgs
+				(
+					args,
+					Path::ValidOnly::No,
+					Path::SkipArg0::No
+				);
+
+				QCOMPARE(paths.size(), args.size());
+			}
+		);
+
+		QVERIFY2(count <= baseline + SLACK, _message(count, baseline));
+	}
+
+	void findIn()
+	{
+		FixtureTree tree({ 2, 4, 12 });
+		QVERIFY(tree.isValid());
+
+		auto baseline = AllocationCounter::during
+		(
+			[&]
+			{
+				QList<Path> paths{};
+
+				QDirIterator it
+				(
+					tree.path(),
+					{ "*.cpp" },
+					QDir::Files,
+					QDirIterator::Subdirectories
+				);
+
+				while (it.hasNext())
+					paths.append(Path(it.next()));
+			}
+		);
+
+		auto count = AllocationCounter::during
+		(
+			[&]
+			{
+				auto paths = Path::findIn(tree.path(), "cpp");
+				QCOMPARE(paths.size(), qsizetype(tree.fileCount("cpp")));
+			}
+		);
+
+		QVERIFY2(count <= baseline + SLACK, _message(count, baseline));
+	}
+
+private:
+	constexpr static auto LONG =
+		"/home/user/projects/cc/include/a/path/long/enough/to/spill/";
+	constexpr static auto ARG_COUNT = 500;
+	constexpr static std::uint64_t SLACK = 32;
+
+	static const char* _message(std::uint64_t count, std::uint64_t baseline)
+	{
+		thread_local std::string message{};
+
+		message = std::to_string(count) + " allocations, baseline "
+			+ std::to_string(baseline);
+
+		return message.c_str();
+	}
+
+}; // class PathAllocationTest
+
+QTEST_GUILESS_MAIN(PathAllocationTest)
+#include "PathAllocationTest.moc"
@@ -0,0 +1,187 @@
+/*
+* cc/bench/PathBench.cpp  Copyright (C) 2026  fairybow
+*
+* You should have received a copy of the GNU General Public License along with
+* this program. If not, see <https://www.gnu.org/licenses/>.
+*
+* This file uses Qt 6. Qt is a free and open-source widget toolkit for creating
+* graphical user interfaces. For more information, visit <https://www.qt.io/>.
+*
+* Updated: 2026-10-16
+*/
+
+#include "Bench.hpp"
+#include "FixtureTree.hpp"
+
+#include "Path.hpp"
+
+#include <QObject>
+#include <QString>
+#include <QTest>
+
+#include <functional>
+#include <string>
+
+/// @brief Times Path's hot paths (QBENCHMARK) and prints the allocations
+/// each operation makes. findIn runs on a generated FixtureTree
+class PathBench : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void initTestCase()
+	{
+		QVERIFY(m_tree.isValid());
+		QVERIFY(m_tree.fileCount() > 0);
+
+		m_existing = Path(m_tree.path()) / "file_000.txt";
+	}
+
+	void constructFromQString()
+	{
+		QString string = SAMPLE;
+
+		QBENCHMARK { Bench::keep(Path(string)); }
+		Bench::reportAllocations([&] { Bench::keep(Path(string)); });
+	}
+
+	void constructFromStdString()
+	{
+		std::string string = SAMPLE;
+
+		QBENCHMARK { Bench::keep(Path(string)); }
+		Bench::reportAllocations([&] { Bench::keep(Path(string)); });
+	}
+
+	void join()
+	{
+		Path base(SAMPLE_FOLDER);
+
+		QBENCHMARK { Bench::keep(base / "component" / "file.txt"); }
+		Bench::reportAllocations([&] { Bench::keep(base / "component" / "file.txt"); });
+	}
+
+	/// @brief A fresh Path each time, so the QString cache never helps
+	void toQStringUncached()
+	{
+		std::string string = SAMPLE;
+
+		QBENCHMARK { Bench::keep(Path(string).toQString()); }
+		Bench::reportAllocations([&] { Bench::keep(Path(string).toQString()); });
+	}
+
+	void toQStringCached()
+	{
+		Path path{ std::string(SAMPLE) };
+		path.toQString();
+
+		QBENCHMARK { Bench::keep(path.toQString()); }
+		Bench::reportAllocations([&] { Bench::keep(path.toQString()); });
+	}
+
+	void toStringNormalized()
+	{
+		Path path{ std::string(MIXED_SEPARATORS) };
+
+		QBENCHMARK { Bench::keep(path.toString(Path::Normalize::Yes)); }
+
+		Bench::reportAllocations
+		(
+			[&] { Bench::keep(path.toString(Path::Normalize::Yes)); }
+		);
+	}
+
+	/// @brief Before args(): one arg() per placeholder, each a full pass
+	/// that converts to QString and back
+	void argChained()
+	{
+		Path pattern(PATTERN);
+		QString name = "shot";
+
+		auto format = [&]
+			{
+				return pattern.arg(42).arg(name).arg(7).arg("png");
+			};
+
+		QBENCHMARK { Bench::keep(format()); }
+		Bench::reportAllocations([&] { Bench::keep(format()); });
+	}
+
+	void argsOnePass()
+	{
+		Path pattern(PATTERN);
+		QString name = "shot";
+
+		auto format = [&] { return pattern.args(42, name, 7, "png"); };
+
+		QBENCHMARK { Bench::keep(format()); }
+		Bench::reportAllocations([&] { Bench::keep(format()); });
+	}
+
+	void hash()
+	{
+		Path path(SAMPLE);
+		std::hash<Path> hasher{};
+
+		QBENCHMARK { Bench::keep(hasher(path)); }
+		Bench::reportAllocations([&] { Bench::keep(hasher(path)); });
+	}
+
+	void isValidExisting()
+	{
+		QBENCHMARK { Bench::keep(m_existing.isValid()); }
+		Bench::reportAllocations([&] { Bench::keep(m_existing.isValid()); });
+	}
+
+	void isValidMissing()
+	{
+		auto missing = Path(m_tree.path()) / "missing.txt";
+
+		QBENCHMARK { Bench::keep(missing.isValid()); }
+		Bench::reportAllocations([&] { Bench::keep(missing.isValid()); });
+	}
+
+	void findIn_data()
+	{
+		QTest::addColumn<bool>("parallel");
+
+		QTest::newRow("serial") << false;
+		QTest::newRow("parallel") << true;
+	}
+
+	void findIn()
+	{
+		QFETCH(bool, parallel);
+
+		auto mode = parallel ? Path::Parallel::Yes : Path::Parallel::No;
+		auto find = [&]
+			{
+				return Path::findIn
+				(
+					m_tree.path(),
+					"cpp",
+					Path::Recursive::Yes,
+					mode
+				);
+			};
+
+		QCOMPARE(find().size(), qsizetype(m_tree.fileCount("cpp")));
+
+		QBENCHMARK { Bench::keep(find()); }
+		Bench::reportAllocations([&] { Bench::keep(find()); }, 10);
+	}
+
+private:
+	constexpr static auto SAMPLE = "/home/user/projects/cc/include/Path.hpp";
+	constexpr static auto SAMPLE_FOLDER = "/home/user/projects/cc/include";
+	constexpr static auto PATTERN = "/renders/%1/frame_%2_v%3.%4";
+	constexpr static auto MIXED_SEPARATORS =
+		"C:\\Users//user\\\\projects/cc\\include//Path.hpp";
+
+	FixtureTree m_tree{};
+	Path m_existing{};
+
+}; // class PathBench
+
+QTEST_GUILESS_MAIN(PathBench)
+#include "PathBench.moc"
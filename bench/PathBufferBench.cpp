@@ -0,0 +1,155 @@
+/*
+* cc/bench/PathBufferBench.cpp  Copyright (C) 2026  fairybow
+*
+* You should have received a copy of the GNU General Public License along with
+* this program. If not, see <https://www.gnu.org/licenses/>.
+*
+* This file uses Qt 6. Qt is a free and open-source widget toolkit for creating
+* graphical user interfaces. For more information, visit <https://www.qt.io/>.
+*
+* Updated: 2026-10-16
+*/
+
+#include "Bench.hpp"
+
+#include "Path.hpp"
+#include "PathBuffer.hpp"
+
+#include <QObject>
+#include <QTest>
+
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+
+/// @brief Path building and decomposition, before (Path, which allocates
+/// through std::filesystem::path) and after (PathBuffer). Each pair does the
+/// same work, so the allocations/op lines compare directly
+class PathBufferBench : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void joinPath()
+	{
+		Path base(ROOT);
+
+		auto build = [&]
+			{
+				auto path = base;
+
+				for (auto component : COMPONENTS)
+					path /= component;
+
+				return path;
+			};
+
+		QBENCHMARK { Bench::keep(build()); }
+		Bench::reportAllocations([&] { Bench::keep(build()); });
+	}
+
+	void joinBuffer()
+	{
+		auto build = [&]
+			{
+				PathBuffer path(ROOT);
+
+				for (auto component : COMPONENTS)
+					path /= component;
+
+				return path.size();
+			};
+
+		QBENCHMARK { Bench::keep(build()); }
+		Bench::reportAllocations([&] { Bench::keep(build()); });
+	}
+
+	void decomposePath()
+	{
+		Path path(SAMPLE);
+
+		auto decompose = [&]
+			{
+				return path.parent().native().size()
+					+ path.file().native().size()
+					+ path.stem().native().size()
+					+ path.extension().native().size();
+			};
+
+		QBENCHMARK { Bench::keep(decompose()); }
+		Bench::reportAllocations([&] { Bench::keep(decompose()); });
+	}
+
+	void decomposeBuffer()
+	{
+		PathBuffer path(SAMPLE);
+
+		auto decompose = [&]
+			{
+				return path.parentView().size()
+					+ path.file().size()
+					+ path.stem().size()
+					+ path.extension().size();
+			};
+
+		QBENCHMARK { Bench::keep(decompose()); }
+		Bench::reportAllocations([&] { Bench::keep(decompose()); });
+	}
+
+	/// @brief Paths too long for the inline buffer, spilled to the default
+	/// resource or to an arena that's reset between batches
+	void spillBuffer_data()
+	{
+		QTest::addColumn<bool>("arena");
+
+		QTest::newRow("default") << false;
+		QTest::newRow("arena") << true;
+	}
+
+	void spillBuffer()
+	{
+		QFETCH(bool, arena);
+
+		std::string longComponent(512, 'x'); // Past the 256-char inline buffer
+		std::array<std::byte, 64 * 1024> storage{};
+		std::pmr::monotonic_buffer_resource monotonic
+		(
+			storage.data(),
+			storage.size(),
+			std::pmr::null_memory_resource()
+		);
+
+		auto resource = arena
+			? static_cast<std::pmr::memory_resource*>(&monotonic)
+			: std::pmr::get_default_resource();
+
+		auto build = [&]
+			{
+				std::size_t total = 0;
+
+				for (auto i = 0; i < BATCH; ++i)
+				{
+					PathBuffer path(ROOT, resource);
+					path /= longComponent;
+					total += path.size();
+				}
+
+				monotonic.release();
+				return total;
+			};
+
+		QBENCHMARK { Bench::keep(build()); }
+		Bench::reportAllocations([&] { Bench::keep(build()); }, 100);
+	}
+
+private:
+	constexpr static auto ROOT = "/home/user/projects";
+	constexpr static auto SAMPLE = "/home/user/projects/cc/include/Path.hpp";
+	constexpr static std::array COMPONENTS{ "cc", "include", "Path.hpp" };
+	constexpr static auto BATCH = 16;
+
+}; // class PathBufferBench
+
+QTEST_GUILESS_MAIN(PathBufferBench)
+#include "PathBufferBench.moc"
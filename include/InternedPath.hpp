@@ -0,0 +1,177 @@
+#pragma once
+
+/*
+* cc/InternedPath.hpp  Copyright (C) 2026  fairybow
+*
+* You should have received a copy of the GNU General Public License along with
+* this program. If not, see <https://www.gnu.org/licenses/>.
+*
+* This file uses Qt 6. Qt is a free and open-source widget toolkit for creating
+* graphical user interfaces. For more information, visit <https://www.qt.io/>.
+*
+* Updated: 2026-10-16
+*/
+
+#include "Path.hpp"
+
+#include <array>
+#include <cstddef>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+/// @brief A pointer-sized handle to a Path stored once in a global pool.
+/// Equality is a pointer comparison and the hash is computed at interning
+/// @details Paths are pooled by their native string with separator runs
+/// collapsed, so "a//b" and "a/b" share an entry (as they compare equal as
+/// Paths). A leading pair, as in a UNC root (\\server\share), is kept
+/// as-is. Entries live until the process exits. Interning is thread-safe
+class InternedPath
+{
+public:
+	using string_type = std::filesystem::path::string_type;
+
+	InternedPath() = default;
+	InternedPath(const Path& path) : m_entry(_intern(path.native())) {}
+
+	bool operator==(const InternedPath& other) const = default;
+	bool operator!=(const InternedPath& other) const = default;
+
+	explicit operator bool() const { return m_entry != nullptr; }
+
+	bool isEmpty() const { return m_entry == nullptr; }
+
+	std::size_t hash() const { return m_entry ? m_entry->hash : 0; }
+
+	const string_type& native() const
+	{
+		static const string_type empty{};
+		return m_entry ? m_entry->string : empty;
+	}
+
+	Path toPath() const { return Path(std::filesystem::path(native())); }
+
+	// Explicit, as an implicit conversion both ways would make
+	// interned == path ambiguous
+	explicit operator Path() const { return toPath(); }
+
+	/// @brief Returns the number of distinct paths interned so far
+	static std::size_t poolSize()
+	{
+		std::size_t size = 0;
+
+		for (auto& shard : _shards())
+		{
+			std::shared_lock lock(shard.mutex);
+			size += shard.entries.size();
+		}
+
+		return size;
+	}
+
+private:
+	using char_type = string_type::value_type;
+	using view_type = std::basic_string_view<char_type>;
+
+	struct Entry
+	{
+		string_type string{};
+		std::size_t hash = 0;
+	};
+
+	// Carries the hash so the map doesn't compute it a second time
+	struct Key
+	{
+		view_type view{};
+		std::size_t hash = 0;
+
+		bool operator==(const Key& other) const { return view == other.view; }
+	};
+
+	struct KeyHash
+	{
+		std::size_t operator()(const Key& key) const { return key.hash; }
+	};
+
+	struct Shard
+	{
+		std::shared_mutex mutex{};
+		std::deque<Entry> entries{}; // Stable addresses
+		std::unordered_map<Key, const Entry*, KeyHash> lookup{};
+	};
+
+	constexpr static std::size_t SHARD_COUNT = 16;
+
+	const Entry* m_entry = nullptr;
+
+	static std::array<Shard, SHARD_COUNT>& _shards()
+	{
+		static std::array<Shard, SHARD_COUNT> shards{};
+		return shards;
+	}
+
+	static const Entry* _intern(const string_type& native)
+	{
+		string_type collapsed{};
+		collapsed.reserve(native.size());
+
+		// A leading "\\" or "//" (exactly two) starts a network root name
+		std::size_t start = 0;
+
+		if (native.size() > 2 && Path::isSeparator(native[0])
+			&& Path::isSeparator(native[1]) && !Path::isSeparator(native[2]))
+		{
+			collapsed.append(native, 0, 2);
+			start = 2;
+		}
+
+		for (auto i = start; i < native.size(); ++i)
+			if (!Path::isSeparator(native[i]) || collapsed.empty()
+				|| !Path::isSeparator(collapsed.back()))
+				collapsed += native[i];
+
+		if (collapsed.empty()) return nullptr;
+
+		Key key{ collapsed, std::hash<view_type>{}(collapsed) };
+		auto& shard = _shards()[key.hash % SHARD_COUNT];
+
+		{
+			std::shared_lock lock(shard.mutex);
+			auto it = shard.lookup.find(key);
+			if (it != shard.lookup.end()) return it->second;
+		}
+
+		std::unique_lock lock(shard.mutex);
+
+		// Another thread may have interned it between the locks
+		auto it = shard.lookup.find(key);
+		if (it != shard.lookup.end()) return it->second;
+
+		auto& entry = shard.entries.emplace_back
+		(
+			Entry{ std::move(collapsed), key.hash }
+		);
+
+		shard.lookup.emplace(Key{ entry.string, entry.hash }, &entry);
+		return &entry;
+	}
+
+}; // class InternedPath
+
+// Provides std::hash compatibility
+namespace std
+{
+	template <>
+	struct hash<InternedPath>
+	{
+		std::size_t operator()(const InternedPath& path) const noexcept
+		{
+			return path.hash();
+		}
+	};
+}
@@ -9,27 +9,60 @@
 * This file uses Qt 6. Qt is a free and open-source widget toolkit for creating
 * graphical user interfaces. For more information, visit <https://www.qt.io/>.
 *
-* Updated: 2024-09-22
+* Updated: 2026-10-16
 */
 
+#include "PathDigest.hpp"
+#include "PathFileOps.hpp"
+#include "PathGlob.hpp"
+#include "PathNormalizer.hpp"
+#include "PathWorkers.hpp"
+
+#include <QByteArrayView>
 #include <QChar>
+#include <QCoreApplication>
 #include <QDebug>
 #include <QDir>
 #include <QDirIterator>
+#include <QFile>
 #include <QFileDialog>
 #include <QFileInfo>
 #include <QList>
 #include <QStandardPaths>
 #include <QString>
+#include <QStringView>
 #include <QTextStream>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <ostream>
+#include <set>
+#include <shared_mutex>
+#include <span>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <unordered_map>
+#include <utility>
+#include <vector>
+
+#ifdef Q_OS_LINUX
+#include <sys/mman.h>
+#endif
 
 // Forward declare for std::hash forward declaration lol
 class Path;
+class PathList;
 
 namespace std
 {
@@ -48,9 +81,13 @@ namespace std
 class Path
 {
 public:
+	enum class Access { Normal = 0, Sequential, Random };
 	enum class Normalize { No = 0, Yes };
+	enum class Parallel { No = 0, Yes };
 	enum class Recursive { No = 0, Yes };
+	enum class ResponseFiles { No = 0, Yes };
 	enum class SkipArg0 { No = 0, Yes };
+	enum class Sort { No = 0, Yes };
 	enum class ValidOnly { No = 0, Yes };
 
 	enum System
@@ -79,33 +116,327 @@ public:
 		Templates
 	};
 
+	struct DiskUsage;
+	class Mapping;
+	class Walk;
+
 	Path() : m_path(std::filesystem::path{}) {}
 	Path(const std::filesystem::path& path) : m_path(path) {}
+	Path(std::filesystem::path&& path) noexcept : m_path(std::move(path)) {}
 	Path(const char* path) : m_path(path) {}
 	Path(const std::string& path) : m_path(path) {}
-	Path(const QString& path) : m_path(path.toStdString()) {}
+	Path(std::string&& path) : m_path(std::move(path)) {}
+	Path(std::string_view path) : m_path(path) {}
 	Path(System location) : m_path(_fromSystem(location)) {}
 
+	// Keeps the QString, so toQString() and the queries don't convert back
+	Path(const QString& path)
+		: m_path(path.toStdString())
+		, m_qString(path)
+		, m_qStringCache(QStringCache::Ready)
+	{
+	}
+
+	Path(QStringView path) : m_path(_fromUtf16(path)) {}
+
+	Path(const Path& other) : m_path(other.m_path)
+	{
+		_copyQStringCache(other);
+	}
+
+	// Not defaulted: the atomic cache state can't be moved, only re-stored
+	Path(Path&& other) noexcept : m_path(std::move(other.m_path))
+	{
+		_moveQStringCache(other);
+	}
+
+	/// @brief True for '/' and the platform's preferred separator, the
+	/// characters std::filesystem splits a native path on
+	constexpr static bool isSeparator(std::filesystem::path::value_type ch)
+	{
+		return ch == std::filesystem::path::value_type('/')
+			|| ch == std::filesystem::path::preferred_separator;
+	}
+
+	/// @brief Clears the cached System locations, so the next Path(System)
+	/// asks Qt again (e.g., after creating a location that was missing, or
+	/// after the environment changes). Changing the organization or
+	/// application name doesn't need this: the locations under them are
+	/// cached per name
+	static void invalidateSystemCache()
+	{
+		auto& cache = _systemCache();
+		std::unique_lock lock(cache.mutex);
+
+		for (auto& path : cache.paths)
+			path.reset();
+
+		cache.organization.clear();
+		cache.application.clear();
+		++cache.generation;
+	}
+
+	/// @brief Forgets resolved prefixes and symlinks, so canonical() and
+	/// friends look at the filesystem again. With a prefix, only entries at or
+	/// under it (or resolving into it) are dropped
+	static void invalidateCanonicalCache(const Path& prefix = {})
+	{
+		auto& cache = _canonicalCache();
+		std::unique_lock lock(cache.mutex);
+
+		if (prefix.isEmpty())
+		{
+			cache.resolved.clear();
+			return;
+		}
+
+		// Entries are absolute and normalized, so match the prefix the same
+		// way. A trailing separator leaves an empty last component, which
+		// would match nothing
+		std::error_code error{};
+		auto base = std::filesystem::absolute(prefix.m_path, error);
+		if (error) base = prefix.m_path;
+
+		base = base.lexically_normal();
+		if (base.has_relative_path() && !base.has_filename())
+			base = base.parent_path();
+
+		auto is_under = [&](const std::filesystem::path& path)
+			{
+				auto mismatch = std::mismatch
+				(
+					base.begin(),
+					base.end(),
+					path.begin(),
+					path.end()
+				);
+
+				return mismatch.first == base.end();
+			};
+
+		std::erase_if
+		(
+			cache.resolved,
+			[&](const auto& entry)
+			{
+				return is_under(entry.first) || is_under(entry.second.path);
+			}
+		);
+	}
+
 	/// @brief Creates all directories in the specified path
 	static bool mkdir(const Path& path)
 	{
 		return std::filesystem::create_directories(path.m_path);
 	}
 
+	/// @brief Creates every directory in paths (and their parents), returning
+	/// the ones that couldn't be created (an empty list means success)
+	/// @details Shared parents are created or found existing once per batch,
+	/// not once per path. Directories are made a level at a time, siblings
+	/// across a thread pool; a failed directory fails everything below it
+	/// without further syscalls. A root (e.g., "/" or "C:\") has nothing to
+	/// create and succeeds if it exists
+	static QList<Path> mkdirAll(const QList<Path>& paths, int threadCount = 0)
+	{
+		constexpr auto none = static_cast<std::size_t>(-1);
+
+		struct Folder
+		{
+			std::filesystem::path path{};
+			std::size_t parent = none;
+		};
+
+		// Each directory once, parents before children
+		std::unordered_map<std::filesystem::path::string_type, std::size_t>
+			indexes{};
+		std::vector<Folder> folders{};
+		std::vector<std::vector<std::size_t>> levels{};
+		std::vector<std::size_t> targets(paths.size(), none);
+		std::vector<std::size_t> depths{};
+		std::vector<char> roots(paths.size(), 0); // Existing roots
+
+		for (qsizetype i = 0; i < paths.size(); ++i)
+		{
+			auto folder = paths[i].m_path.lexically_normal();
+			if (!folder.has_filename()) folder = folder.parent_path();
+
+			if (!folder.has_relative_path())
+			{
+				std::error_code error{};
+				roots[i] = !folder.empty()
+					&& std::filesystem::is_directory(folder, error);
+
+				continue;
+			}
+
+			std::vector<std::filesystem::path> chain{};
+			auto parent = none;
+
+			for (auto up = folder; up.has_relative_path(); up = up.parent_path())
+			{
+				auto it = indexes.find(up.native());
+
+				if (it != indexes.end())
+				{
+					parent = it->second;
+					break;
+				}
+
+				chain.push_back(up);
+			}
+
+			for (auto it = chain.rbegin(); it != chain.rend(); ++it)
+			{
+				auto depth = (parent == none) ? 0 : depths[parent] + 1;
+				auto index = folders.size();
+
+				folders.push_back({ *it, parent });
+				depths.push_back(depth);
+				indexes.emplace(it->native(), index);
+
+				if (levels.size() <= depth) levels.resize(depth + 1);
+				levels[depth].push_back(index);
+
+				parent = index;
+			}
+
+			targets[i] = parent;
+		}
+
+		std::vector<char> created(folders.size(), 0);
+
+		for (auto& level : levels)
+		{
+			PathWorkers::forEach
+			(
+				level.size(),
+				[&](int, std::size_t i)
+				{
+					auto& folder = folders[level[i]];
+					if (folder.parent != none && !created[folder.parent]) return;
+
+					// False without error when it already exists as a directory
+					std::error_code error{};
+					std::filesystem::create_directory(folder.path, error);
+					created[level[i]] = !error;
+				},
+				PathWorkers::threadsFor(level.size(), threadCount)
+			);
+		}
+
+		QList<Path> failed{};
+
+		for (qsizetype i = 0; i < paths.size(); ++i)
+			if (!roots[i] && (targets[i] == none || !created[targets[i]]))
+				failed << paths[i];
+
+		return failed;
+	}
+
+	/// @brief Running totals passed to tree operation progress callbacks
+	struct Progress
+	{
+		std::uint64_t files = 0;
+		std::uint64_t bytes = 0;
+	};
+
+	/// @brief Called after each file, from worker threads but never two at
+	/// once
+	using ProgressCallback = std::function<void(const Progress&)>;
+
+	/// @brief Polled between files; return true to stop. Work already done
+	/// isn't undone
+	using CancelCallback = std::function<bool()>;
+
+	/// @brief Copies the tree at from into to (created if missing), spread
+	/// across a thread pool. Existing files are replaced and symlinks are
+	/// copied as links; a symlink already in the destination is replaced,
+	/// never followed. Sockets, FIFOs, and devices aren't copied and count as
+	/// failures. Returns false on any failure or cancellation
+	/// @details On Linux, files are reflinked where the filesystem allows,
+	/// then copied in-kernel with copy_file_range, then buffered
+	static bool copyTree
+	(
+		const Path& from,
+		const Path& to,
+		const ProgressCallback& progress = {},
+		const CancelCallback& cancel = {},
+		int threadCount = 0
+	)
+	{
+		TreeProgress tracker(progress, cancel);
+		return _copyTree(from.m_path, to.m_path, tracker, threadCount);
+	}
+
+	/// @brief Moves the tree at from to to, which mustn't exist. A rename
+	/// when both are on one filesystem (no progress is reported); otherwise
+	/// copyTree then removeTree
+	static bool moveTree
+	(
+		const Path& from,
+		const Path& to,
+		const ProgressCallback& progress = {},
+		const CancelCallback& cancel = {},
+		int threadCount = 0
+	)
+	{
+		switch (PathFileOps::rename(from.m_path, to.m_path))
+		{
+		case PathFileOps::Rename::Done:
+			return true;
+
+		case PathFileOps::Rename::Failed:
+			return false;
+
+		case PathFileOps::Rename::CrossDevice:
+			break;
+		}
+
+		std::error_code error{};
+		if (std::filesystem::exists(to.m_path, error)) return false;
+
+		// Progress covers the copy; the cleanup only watches for cancel
+		TreeProgress copying(progress, cancel);
+		TreeProgress cleanup({}, cancel);
+
+		return _copyTree(from.m_path, to.m_path, copying, threadCount)
+			&& _removeTree(from.m_path, cleanup, threadCount);
+	}
+
+	/// @brief Removes path and, if it's a directory, everything under it.
+	/// Files go in parallel; directories are removed deepest first
+	static bool removeTree
+	(
+		const Path& path,
+		const ProgressCallback& progress = {},
+		const CancelCallback& cancel = {},
+		int threadCount = 0
+	)
+	{
+		TreeProgress tracker(progress, cancel);
+		return _removeTree(path.m_path, tracker, threadCount);
+	}
+
 	/// @brief Returns a list of Paths from Qt application arguments
+	/// @details With ResponseFiles::Yes, an "@list" argument is replaced by
+	/// the lines of the file list (one path per line). If list can't be
+	/// opened, the argument is kept as a path, "@" and all. Validation of
+	/// long lists runs across a thread pool but keeps the input order
 	static QList<Path> fromArgs
 	(
 		const QStringList& args,
 		ValidOnly validOnly = ValidOnly::Yes,
-		SkipArg0 skipArg0 = SkipArg0::Yes
+		SkipArg0 skipArg0 = SkipArg0::Yes,
+		ResponseFiles responseFiles = ResponseFiles::No
 	)
 	{
 		QList<Path> paths{};
 
 		for (int i = (skipArg0 == SkipArg0::Yes); i < args.size(); ++i)
-			_argHelper(args[i], paths, validOnly);
+			_argHelper(args[i], paths, responseFiles);
 
-		return paths;
+		return _validArgs(std::move(paths), validOnly);
 	}
 
 	/// @brief Returns a list of Paths from application arguments
@@ -114,48 +445,87 @@ public:
 		int argc,
 		char* argv[],
 		ValidOnly validOnly = ValidOnly::Yes,
-		SkipArg0 skipArg0 = SkipArg0::Yes
+		SkipArg0 skipArg0 = SkipArg0::Yes,
+		ResponseFiles responseFiles = ResponseFiles::No
 	)
 	{
 		QList<Path> paths{};
 
 		for (int i = (skipArg0 == SkipArg0::Yes); i < argc; ++i)
-			_argHelper(argv[i], paths, validOnly);
+			_argHelper(argv[i], paths, responseFiles);
 
-		return paths;
+		return _validArgs(std::move(paths), validOnly);
 	}
 
-	/// @todo Sort?
+	/// @brief Returns all files under directory with the given extension
+	/// @details Parallel::Yes (recursive only) spreads subdirectories across
+	/// a work-stealing pool and returns the same set of Paths in no particular
+	/// order. Sort::Yes orders results by path, so either mode is deterministic
 	static QList<Path> findIn
 	(
 		const Path& directory,
 		const QString& extension,
-		Recursive recursive = Recursive::Yes
+		Recursive recursive = Recursive::Yes,
+		Parallel parallel = Parallel::No,
+		Sort sort = Sort::No
 	)
 	{
 		QList<Path> paths{};
 
-		auto iterator_flag = (recursive == Recursive::Yes)
-			? QDirIterator::Subdirectories
-			: QDirIterator::NoIteratorFlags;
+		if (recursive == Recursive::Yes && parallel == Parallel::Yes)
+			paths = _findInParallel(directory, extension);
+		else
+		{
+			auto it = _extensionIterator(directory, extension, recursive);
+
+			while (it.hasNext())
+			{
+				it.next();
+				paths << it.filePath();
+			}
+		}
+
+		if (sort == Sort::Yes)
+			_sort(paths);
 
-		QDirIterator it
+		return paths;
+	}
+
+	/// @brief Returns all files under directory matching the globs (see
+	/// PathGlob), e.g. QStringList{ "**/*.{cpp,hpp}", "!build/**" }
+	/// @details The tree is walked once however many patterns there are, and
+	/// excluded directories (or ones no include can reach into) are never
+	/// listed. Parallel and Sort work as in the extension overload
+	static QList<Path> findIn
+	(
+		const Path& directory,
+		const PathGlob& glob,
+		Parallel parallel = Parallel::No,
+		Sort sort = Sort::No
+	)
+	{
+		auto paths = _findInGlob
 		(
-			directory.toQString(),
-			QStringList{} << "*." + extension,
-			QDir::Files,
-			iterator_flag
+			directory,
+			glob,
+			(parallel == Parallel::Yes) ? 0 : 1
 		);
 
-		while (it.hasNext())
-		{
-			it.next();
-			paths << it.filePath();
-		}
+		if (sort == Sort::Yes)
+			_sort(paths);
 
 		return paths;
 	}
 
+	/// @brief Lazily yields files under directory with the given extension,
+	/// one per step, so callers can stop early and memory stays flat
+	static Walk walk
+	(
+		const Path& directory,
+		const QString& extension,
+		Recursive recursive = Recursive::Yes
+	);
+
 	// Stream:
 
 	friend QTextStream& operator<<(QTextStream& outStream, const Path& path)
@@ -184,19 +554,42 @@ public:
 	Path& operator=(const Path& other)
 	{
 		if (this != &other)
+		{
 			m_path = other.m_path;
+			_invalidateQString();
+			_copyQStringCache(other);
+		}
+
+		return *this;
+	}
+
+	Path& operator=(Path&& other) noexcept
+	{
+		if (this != &other)
+		{
+			m_path = std::move(other.m_path);
+			_invalidateQString();
+			_moveQStringCache(other);
+		}
 
 		return *this;
 	}
 
 	// Comparison:
 
-	bool operator==(const Path& other) const = default;
-	bool operator!=(const Path& other) const = default;
+	bool operator==(const Path& other) const
+	{
+		return m_path == other.m_path;
+	}
+
+	bool operator!=(const Path& other) const
+	{
+		return !(*this == other);
+	}
 
 	// Concatenation:
 
-	Path operator/(const Path& other) const
+	Path operator/(const Path& other) const&
 	{
 		Path path = *this;
 		path /= other;
@@ -204,15 +597,26 @@ public:
 		return path;
 	}
 
+	// Appends to a temporary's own buffer, so a / b / c copies nothing
+	Path operator/(const Path& other) &&
+	{
+		*this /= other;
+		return std::move(*this);
+	}
+
 	Path& operator/=(const Path& other)
 	{
 		m_path /= other.m_path;
+		_invalidateQString();
+
 		return *this;
 	}
 
 	Path& operator+=(const Path& other)
 	{
 		m_path += other.m_path;
+		_invalidateQString();
+
 		return *this;
 	}
 
@@ -223,11 +627,17 @@ public:
 		return !m_path.empty();
 	}
 
-	operator std::filesystem::path() const
+	operator std::filesystem::path() const&
 	{
 		return m_path;
 	}
 
+	operator std::filesystem::path() && noexcept
+	{
+		_invalidateQString();
+		return std::move(m_path);
+	}
+
 	// operator QVariant() const
 	// {
 	// 	return toQVariant();
@@ -270,6 +680,10 @@ public:
 	)
 		const
 	{
+		// Separator only applies when normalizing
+		if (normalize == Normalize::No)
+			return _cachedQString();
+
 		return QString::fromStdString
 		(
 			toString(normalize, separator)
@@ -281,11 +695,23 @@ public:
 	// 	return QVariant::fromValue(toQString());
 	// }
 
-	std::filesystem::path toStd() const
+	const std::filesystem::path& toStd() const& noexcept
 	{
 		return m_path;
 	}
 
+	std::filesystem::path toStd() && noexcept
+	{
+		_invalidateQString();
+		return std::move(m_path);
+	}
+
+	/// @brief The native string, without copying
+	const std::filesystem::path::string_type& native() const noexcept
+	{
+		return m_path.native();
+	}
+
 	std::string toString
 	(
 		Normalize normalize = Normalize::No,
@@ -293,12 +719,63 @@ public:
 	)
 		const
 	{
-		auto string = m_path.string();
-
 		if (normalize == Normalize::Yes)
-			return _normalizer(string, separator);
+			return _normalizer(separator);
 
-		return string;
+		return m_path.string();
+	}
+
+	/// @brief Normalizes every path into one buffer, each followed by
+	/// delimiter. Where native strings are narrow, the buffer is sized once
+	/// and written in place
+	static std::string toString
+	(
+		const QList<Path>& paths,
+		char delimiter = '\n',
+		char separator = '/'
+	)
+	{
+		std::size_t capacity = 0;
+
+		for (auto& path : paths)
+			capacity += path.m_path.native().size() + 1;
+
+		std::string buffer{};
+
+		if constexpr (NARROW_NATIVE)
+		{
+			buffer.resize(capacity);
+			std::size_t size = 0;
+
+			for (auto& path : paths)
+			{
+				auto& native = path.m_path.native();
+
+				size += PathNormalizer::normalize
+				(
+					native.data(),
+					native.size(),
+					buffer.data() + size,
+					separator
+				);
+
+				buffer[size++] = delimiter;
+			}
+
+			buffer.resize(size);
+		}
+		else
+		{
+			buffer.reserve(capacity);
+
+			for (auto& path : paths)
+			{
+				buffer += path._normalizer(separator);
+				buffer += delimiter;
+			}
+		}
+
+		return buffer;
 	}
 
 	// Queries:
@@ -329,6 +806,77 @@ public:
 		return QFileInfo(toQString()).exists();
 	}
 
+	/// @brief Hashes the file's contents (see PathDigest), reading in large
+	/// chunks. Returns nothing if the file can't be read
+	std::optional<PathDigest::Digest> fingerprint
+	(
+		PathDigest::Wide wide = PathDigest::Wide::Yes
+	)
+		const
+	{
+		QFile file(toQString());
+		if (!file.open(QIODevice::ReadOnly)) return {};
+
+		PathDigest::Hasher hasher(wide);
+		std::vector<char> buffer(FINGERPRINT_CHUNK);
+
+		while (true)
+		{
+			auto read = file.read(buffer.data(), FINGERPRINT_CHUNK);
+			if (read < 0) return {};
+			if (read == 0) break;
+
+			hasher.update(buffer.data(), static_cast<std::size_t>(read));
+		}
+
+		return hasher.digest();
+	}
+
+	/// @brief Maps the file read-only, so it can be parsed in place instead
+	/// of copied into a QByteArray. Access hints the kernel's read-ahead
+	/// (Linux only; ignored elsewhere)
+	Mapping map(Access access = Access::Normal) const;
+
+	/// @brief Totals this directory and each directory under it, sorted by
+	/// path. Subtrees are walked concurrently and each entry is statted once
+	/// @details Like du: symlinks aren't followed, directories count their
+	/// own size, and a file with several hard links counts once (by device
+	/// and inode). maxDepth limits which directories are listed (0 = just
+	/// this one; -1 = all), not what the totals include
+	QList<DiskUsage> diskUsage(int maxDepth = -1, int threadCount = 0) const;
+
+	/// @brief The absolute path with every symlink, ".", and ".." resolved.
+	/// Returns an empty Path if any part of it doesn't exist
+	/// @details Resolved directories and symlinks are cached (shared across
+	/// threads) by their resolved parent, so paths under a common prefix
+	/// resolve it once. The cache can go stale if links or directories are
+	/// replaced: see invalidateCanonicalCache()
+	Path canonical() const
+	{
+		auto resolved = _resolve(m_path, false, 0);
+		return resolved ? Path(std::move(*resolved)) : Path{};
+	}
+
+	/// @brief As canonical(), but the part from the first missing component
+	/// on is kept (normalized lexically) instead of failing
+	Path weaklyCanonical() const
+	{
+		auto resolved = _resolve(m_path, true, 0);
+		return resolved ? Path(std::move(*resolved)) : Path{};
+	}
+
+	/// @brief This path relative to base, after resolving both as in
+	/// weaklyCanonical(). Empty if there's no relative path between them
+	/// (e.g., different drives)
+	Path relativeTo(const Path& base) const
+	{
+		auto from = _resolve(base.m_path, true, 0);
+		auto to = _resolve(m_path, true, 0);
+		if (!from || !to) return {};
+
+		return to->lexically_relative(*from);
+	}
+
 	// Decomposition:
 
 	Path rootName() const
@@ -376,11 +924,14 @@ public:
 	void clear() noexcept
 	{
 		m_path.clear();
+		_invalidateQString();
 	}
 
 	Path& replaceExt(const Path& replacement = {})
 	{
 		m_path.replace_extension(replacement);
+		_invalidateQString();
+
 		return *this;
 	}
 
@@ -404,72 +955,706 @@ public:
 		return toQString().arg(a, fieldWidth, fillChar);
 	}
 
-	Path& makePreferred() noexcept
+	/// @brief Replaces every %1-%99 placeholder in one pass: the lowest
+	/// numbered with the first argument, the next with the second, and so on
+	/// (like QString::arg(a, b, ...)). Strings, characters, numbers, and Paths
+	/// are written straight into the UTF-8 result
+	/// @details For field widths and fill characters, use arg()
+	template <typename... ArgsT>
+	Path args(const ArgsT&... values) const
 	{
-		m_path.make_preferred();
-		return *this;
-	}
+		static_assert(sizeof...(ArgsT) > 0, "args() needs an argument");
 
-private:
-	std::filesystem::path m_path;
+		std::array<std::string, sizeof...(ArgsT)> texts{ _argText(values)... };
 
-	static void _argHelper
-	(
-		const QString& arg,
-		QList<Path>& paths,
-		ValidOnly validOnly
-	)
-	{
-		Path path(arg);
+		std::string converted{};
+		if constexpr (!NARROW_NATIVE) converted = m_path.string();
+
+		std::string_view source{};
+
+		if constexpr (NARROW_NATIVE)
+			source = m_path.native();
+		else
+			source = converted;
+
+		// Which placeholder numbers occur, then which argument each gets
+		std::array<std::int8_t, 100> argIndex{};
+		argIndex.fill(-1);
+
+		auto placeholder = [&](std::size_t i, int& number)
+			{
+				if (source[i] != '%' || i + 1 >= source.size()) return 0;
+
+				auto digit = [&](std::size_t at)
+					{
+						return at < source.size()
+							&& source[at] >= '0' && source[at] <= '9';
+					};
 
-		if (validOnly == ValidOnly::Yes)
+				if (!digit(i + 1)) return 0;
+
+				number = source[i + 1] - '0';
+				if (!digit(i + 2)) return number ? 2 : 0;
+
+				number = number * 10 + (source[i + 2] - '0');
+				return number ? 3 : 0;
+			};
+
+		for (std::size_t i = 0; i < source.size(); ++i)
 		{
-			if (path.isValid())
-				paths << path;
+			auto number = 0;
+			if (placeholder(i, number)) argIndex[number] = 0;
 		}
-		else
-			paths << path;
-	}
 
-	Path _qStandardLocation(QStandardPaths::StandardLocation type) const
-	{
-		return Path
-		(
-			QStandardPaths::locate
-			(
-				type,
-				{},
-				QStandardPaths::LocateDirectory
-			)
-		);
+		std::int8_t next = 0;
+
+		for (auto& index : argIndex)
+			if (index == 0)
+				index = (next < std::int8_t(texts.size())) ? next++ : -1;
+
+		std::size_t capacity = source.size();
+
+		for (auto& text : texts)
+			capacity += text.size();
+
+		std::string result{};
+		result.reserve(capacity);
+
+		for (std::size_t i = 0; i < source.size(); )
+		{
+			auto number = 0;
+			auto length = placeholder(i, number);
+
+			if (length && argIndex[number] >= 0)
+			{
+				result += texts[argIndex[number]];
+				i += length;
+			}
+			else
+				result += source[i++];
+		}
+
+		return Path(std::filesystem::path(std::move(result)));
 	}
 
-	Path _fromSystem(System type) const
+	Path& makePreferred() noexcept
 	{
-		if (type == Root)
-			return Path(QDir::rootPath());
+		m_path.make_preferred();
+		_invalidateQString();
 
-		auto type_map = _systemToQtType();
-		auto it = type_map.find(type);
+		return *this;
+	}
 
-		if (it != type_map.end())
-			return _qStandardLocation(it->second);
+private:
+	friend class PathList;
 
-		return {};
-	}
+	enum class QStringCache { Empty = 0, Filling, Ready };
 
-	const std::unordered_map
+	constexpr static auto NARROW_NATIVE = std::is_same_v
 		<
-		System,
-		QStandardPaths::StandardLocation
-		>
-		_systemToQtType() const
+		std::filesystem::path::value_type,
+		char
+		>;
+
+	std::filesystem::path m_path;
+
+	// toQString() result, filled by whichever thread converts first. Other
+	// threads convert for themselves until it's Ready, so const use of a
+	// shared Path stays race-free without a lock. This costs a QString and a
+	// state word per Path (with Qt 6 on 64-bit libstdc++, sizeof(Path) is 72
+	// rather than 40) and means copies and moves are written out by hand.
+	// It's kept inline on purpose: Paths made from a QString (QDirIterator
+	// results, dialogs, arguments) hold it with no allocation, whereas a
+	// pointer to an out-of-line cache would add an allocation to each one
+	// (about 20% more allocations in fromArgs and 3% more in findIn)
+	mutable QString m_qString{};
+	mutable std::atomic<QStringCache> m_qStringCache{ QStringCache::Empty };
+
+	QString _cachedQString() const
+	{
+		auto state = m_qStringCache.load(std::memory_order_acquire);
+		if (state == QStringCache::Ready) return m_qString;
+
+		auto string = QString::fromStdString(m_path.string());
+		auto expected = QStringCache::Empty;
+
+		if (m_qStringCache.compare_exchange_strong
+		(
+			expected,
+			QStringCache::Filling,
+			std::memory_order_acquire
+		))
+		{
+			m_qString = string;
+			m_qStringCache.store
+			(
+				QStringCache::Ready,
+				std::memory_order_release
+			);
+		}
+
+		return string;
+	}
+
+	void _copyQStringCache(const Path& other)
+	{
+		auto state = other.m_qStringCache.load(std::memory_order_acquire);
+		if (state != QStringCache::Ready) return;
+
+		m_qString = other.m_qString;
+		m_qStringCache.store(QStringCache::Ready, std::memory_order_relaxed);
+	}
+
+	/// @brief Takes other's cache, if it has one. other is an rvalue, so
+	/// no other thread can be filling it
+	void _moveQStringCache(Path& other) noexcept
+	{
+		auto state = other.m_qStringCache.load(std::memory_order_relaxed);
+		if (state != QStringCache::Ready) return;
+
+		m_qString = std::move(other.m_qString);
+		m_qStringCache.store(QStringCache::Ready, std::memory_order_relaxed);
+		other.m_qStringCache.store
+		(
+			QStringCache::Empty,
+			std::memory_order_relaxed
+		);
+	}
+
+	static std::filesystem::path _fromUtf16(QStringView path)
+	{
+		auto utf8 = path.toUtf8();
+		return std::string_view(utf8.constData(), utf8.size());
+	}
+
+	void _invalidateQString() noexcept
+	{
+		m_qString = QString{};
+		m_qStringCache.store(QStringCache::Empty, std::memory_order_relaxed);
+	}
+
+	constexpr static qint64 FINGERPRINT_CHUNK = 1 << 20;
+
+	template <typename T>
+	static std::string _argText(const T& arg)
+	{
+		if constexpr (std::is_same_v<T, Path>)
+			return arg.toString();
+		else if constexpr (std::is_same_v<T, QString>)
+			return arg.toStdString();
+		else if constexpr (std::is_same_v<T, QStringView>)
+			return arg.toString().toStdString();
+		else if constexpr (std::is_same_v<T, QChar>)
+			return QString(arg).toStdString();
+		else if constexpr (std::is_same_v<T, char>)
+			return std::string(1, arg);
+		else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+			return std::string(std::string_view(arg));
+		else if constexpr (std::is_arithmetic_v<T> && !std::is_same_v<T, bool>)
+		{
+			std::array<char, 64> buffer{};
+			auto end = std::to_chars
+			(
+				buffer.data(),
+				buffer.data() + buffer.size(),
+				arg
+			).ptr;
+
+			return std::string(buffer.data(), end);
+		}
+		else
+			static_assert(!sizeof(T), "Unsupported Path::args() argument");
+	}
+
+	static void _argHelper
+	(
+		const QString& arg,
+		QList<Path>& paths,
+		ResponseFiles responseFiles
+	)
+	{
+		if (responseFiles == ResponseFiles::Yes
+			&& arg.size() > 1 && arg.startsWith(u'@')
+			&& _readResponseFile(arg.mid(1), paths))
+			return;
+
+		paths << Path(arg);
+	}
+
+	/// @brief Appends each non-empty line of the list file. The file is
+	/// memory-mapped when possible and read line by line otherwise. Returns
+	/// false, appending nothing, if it can't be opened
+	static bool _readResponseFile(const QString& listPath, QList<Path>& paths)
+	{
+		QFile file(listPath);
+		if (!file.open(QIODevice::ReadOnly)) return false;
+
+		auto append_line = [&](const char* data, qsizetype size)
+			{
+				while (size > 0
+					&& (data[size - 1] == '\n' || data[size - 1] == '\r'))
+					--size;
+
+				if (size > 0)
+					paths << Path(QString::fromUtf8(data, size));
+			};
+
+		auto size = file.size();
+
+		if (auto data = size > 0 ? file.map(0, size) : nullptr)
+		{
+			auto begin = reinterpret_cast<const char*>(data);
+			auto end = begin + size;
+
+			while (begin < end)
+			{
+				auto newline = std::find(begin, end, '\n');
+				append_line(begin, newline - begin);
+				begin = (newline == end) ? end : newline + 1;
+			}
+
+			file.unmap(data);
+			return true;
+		}
+
+		while (!file.atEnd())
+		{
+			auto line = file.readLine();
+			append_line(line.constData(), line.size());
+		}
+
+		return true;
+	}
+
+	/// @brief Drops invalid paths (if asked), in input order
+	static QList<Path> _validArgs(QList<Path> paths, ValidOnly validOnly)
+	{
+		if (validOnly == ValidOnly::No) return paths;
+
+		auto size = static_cast<std::size_t>(paths.size());
+
+		auto valid = PathWorkers::fill<std::vector<char>>
+		(
+			size,
+			[&](std::size_t i) -> char { return paths.at(i).isValid(); }
+		);
+
+		QList<Path> valid_paths{};
+		valid_paths.reserve(paths.size());
+
+		for (std::size_t i = 0; i < size; ++i)
+			if (valid[i])
+				valid_paths << std::move(paths[i]);
+
+		return valid_paths;
+	}
+
+	/// @brief The serial scan behind findIn, walk, and PathList::findIn
+	static QDirIterator _extensionIterator
+	(
+		const Path& directory,
+		const QString& extension,
+		Recursive recursive
+	)
+	{
+		return QDirIterator
+		(
+			directory.toQString(),
+			QStringList{} << "*." + extension,
+			QDir::Files,
+			(recursive == Recursive::Yes)
+				? QDirIterator::Subdirectories
+				: QDirIterator::NoIteratorFlags
+		);
+	}
+
+	/// @brief Concatenates the per-worker result lists of a parallel scan
+	static QList<Path> _joinResults(std::vector<QList<Path>>& results)
+	{
+		QList<Path> paths{};
+		qsizetype total = 0;
+
+		for (auto& result : results)
+			total += result.size();
+
+		paths.reserve(total);
+
+		for (auto& result : results)
+			paths << std::move(result);
+
+		return paths;
+	}
+
+	/// @brief Lists one directory per task, pushing subdirectories back onto
+	/// the pool. Mirrors QDirIterator::Subdirectories: hidden and symlinked
+	/// directories aren't descended into, and paths are composed the same way
+	static QList<Path> _findInParallel
+	(
+		const Path& directory,
+		const QString& extension
+	)
+	{
+		auto name_filters = QStringList{} << "*." + extension;
+		std::vector<QList<Path>> results(PathWorkers::count());
+
+		PathWorkers::run<QString>
+		(
+			{ directory.toQString() },
+			[&](int worker, QString folder, auto push)
+			{
+				// AllDirs exempts directories from the name filters
+				QDirIterator it
+				(
+					folder,
+					name_filters,
+					QDir::Files | QDir::AllDirs | QDir::NoDotAndDotDot
+				);
+
+				while (it.hasNext())
+				{
+					it.next();
+					auto info = it.fileInfo();
+
+					if (info.isDir())
+					{
+						if (!info.isSymLink())
+							push(it.filePath());
+					}
+					else
+						results[worker] << it.filePath();
+				}
+			}
+		);
+
+		return _joinResults(results);
+	}
+
+	/// @brief As _findInParallel, but each folder carries the glob states
+	/// reached at it, and entries step those states by name
+	static QList<Path> _findInGlob
+	(
+		const Path& directory,
+		const PathGlob& glob,
+		int threadCount
+	)
+	{
+		struct Folder
+		{
+			QString path{};
+			PathGlob::States states{};
+		};
+
+		auto initial = glob.initial();
+		if (glob.prunes(initial)) return {};
+
+		std::vector<QList<Path>> results(PathWorkers::count(threadCount));
+
+		PathWorkers::run<Folder>
+		(
+			{ { directory.toQString(), std::move(initial) } },
+			[&](int worker, Folder folder, auto push)
+			{
+				QDirIterator it
+				(
+					folder.path,
+					QDir::Files | QDir::AllDirs | QDir::NoDotAndDotDot
+				);
+
+				while (it.hasNext())
+				{
+					it.next();
+					auto info = it.fileInfo();
+					auto states = glob.step(folder.states, it.fileName());
+
+					if (info.isDir())
+					{
+						if (!info.isSymLink() && !glob.prunes(states))
+							push({ it.filePath(), std::move(states) });
+					}
+					else if (glob.accepts(states))
+						results[worker] << it.filePath();
+				}
+			},
+			threadCount
+		);
+
+		return _joinResults(results);
+	}
+
+	/// @brief Shared state for one tree operation: totals, the callbacks,
+	/// and whether to stop
+	class TreeProgress
+	{
+	public:
+		TreeProgress
+		(
+			const ProgressCallback& progress,
+			const CancelCallback& cancel
+		)
+			: m_progress(progress)
+			, m_cancel(cancel)
+		{
+		}
+
+		bool ok() const { return !m_stopped.load(std::memory_order_relaxed); }
+
+		void fail() { m_stopped.store(true, std::memory_order_relaxed); }
+
+		bool stopped()
+		{
+			if (!ok()) return true;
+			if (!m_cancel) return false;
+
+			std::lock_guard lock(m_mutex);
+			if (m_cancel()) fail();
+
+			return !ok();
+		}
+
+		void add(std::uint64_t files, std::uint64_t bytes)
+		{
+			std::lock_guard lock(m_mutex);
+
+			m_totals.files += files;
+			m_totals.bytes += bytes;
+
+			if (m_progress) m_progress(m_totals);
+		}
+
+	private:
+		ProgressCallback m_progress;
+		CancelCallback m_cancel;
+		std::mutex m_mutex{};
+		Progress m_totals{};
+		std::atomic<bool> m_stopped{ false };
+	};
+
+	struct TreeJob
+	{
+		std::filesystem::path from{};
+		std::filesystem::path to{};
+		bool isFolder = false;
+	};
+
+	/// @brief Lists one directory per task, pushing each file and
+	/// subdirectory back onto the pool as its own job
+	static bool _copyTree
+	(
+		const std::filesystem::path& from,
+		const std::filesystem::path& to,
+		TreeProgress& tracker,
+		int threadCount
+	)
+	{
+		std::error_code error{};
+		if (!std::filesystem::is_directory(from, error)) return false;
+
+		// Copying a tree into itself would never finish
+		auto canonical_from = std::filesystem::weakly_canonical(from, error);
+		if (error) return false;
+
+		auto canonical_to = std::filesystem::weakly_canonical(to, error);
+		if (error) return false;
+
+		auto mismatch = std::mismatch
+		(
+			canonical_from.begin(),
+			canonical_from.end(),
+			canonical_to.begin(),
+			canonical_to.end()
+		);
+
+		if (mismatch.first == canonical_from.end()) return false;
+
+		PathWorkers::run<TreeJob>
+		(
+			{ { from, to, true } },
+			[&](int, TreeJob job, auto push)
+			{
+				if (tracker.stopped()) return;
+
+				if (!job.isFolder)
+				{
+					std::uint64_t bytes = 0;
+
+					if (PathFileOps::copyFile(job.from, job.to, bytes))
+						tracker.add(1, bytes);
+					else
+						tracker.fail();
+
+					return;
+				}
+
+				if (!_makeFolder(job.to))
+				{
+					tracker.fail();
+					return;
+				}
+
+				std::error_code error{};
+				std::filesystem::directory_iterator it(job.from, error);
+
+				for (; !error && it != std::filesystem::directory_iterator{};
+					it.increment(error))
+				{
+					auto status = it->symlink_status(error);
+					if (error) break;
+
+					auto target = job.to / it->path().filename();
+
+					if (std::filesystem::is_symlink(status))
+					{
+						std::filesystem::remove(target, error);
+						std::filesystem::copy_symlink(it->path(), target, error);
+						if (error) break;
+
+						tracker.add(1, 0);
+					}
+					else if (std::filesystem::is_directory(status))
+						push({ it->path(), target, true });
+					else if (std::filesystem::is_regular_file(status))
+						push({ it->path(), target, false });
+					else
+						tracker.fail(); // Socket, FIFO, or device
+				}
+
+				if (error) tracker.fail();
+			},
+			threadCount
+		);
+
+		return tracker.ok();
+	}
+
+	/// @brief Makes path a real folder, replacing a symlink or other
+	/// non-folder there, so a copy never writes through a link out of the
+	/// destination. Missing parents are created
+	static bool _makeFolder(const std::filesystem::path& path)
+	{
+		std::error_code error{};
+		auto status = std::filesystem::symlink_status(path, error);
+
+		if (std::filesystem::is_directory(status)) return true;
+
+		if (std::filesystem::exists(status)
+			&& !std::filesystem::remove(path, error))
+			return false;
+
+		if (path.has_parent_path())
+		{
+			std::filesystem::create_directories(path.parent_path(), error);
+			if (error) return false;
+		}
+
+		std::filesystem::create_directory(path, error);
+		if (error) return false;
+
+		// create_directory also succeeds if a link to a folder appeared here
+		// in between, so look again
+		status = std::filesystem::symlink_status(path, error);
+		return !error && std::filesystem::is_directory(status);
+	}
+
+	static bool _removeTree
+	(
+		const std::filesystem::path& path,
+		TreeProgress& tracker,
+		int threadCount
+	)
+	{
+		std::error_code error{};
+		auto status = std::filesystem::symlink_status(path, error);
+		if (error) return false;
+
+		if (!std::filesystem::is_directory(status))
+		{
+			if (!std::filesystem::remove(path, error)) return false;
+
+			tracker.add(1, 0);
+			return true;
+		}
+
+		using Folder = std::pair<std::filesystem::path, int>;
+		std::vector<std::vector<Folder>> folders
+		(
+			PathWorkers::count(threadCount)
+		);
+
+		PathWorkers::run<Folder>
+		(
+			{ { path, 0 } },
+			[&](int worker, Folder folder, auto push)
+			{
+				if (tracker.stopped()) return;
+
+				std::error_code error{};
+				std::filesystem::directory_iterator it(folder.first, error);
+
+				for (; !error && it != std::filesystem::directory_iterator{};
+					it.increment(error))
+				{
+					auto status = it->symlink_status(error);
+					if (error) break;
+
+					if (std::filesystem::is_directory(status))
+						push({ it->path(), folder.second + 1 });
+					else if (std::filesystem::remove(it->path(), error))
+						tracker.add(1, 0);
+				}
+
+				if (error) tracker.fail();
+
+				folders[worker].push_back(std::move(folder));
+			},
+			threadCount
+		);
+
+		if (!tracker.ok()) return false;
+
+		std::vector<Folder> all{};
+
+		for (auto& list : folders)
+			all.insert
+			(
+				all.end(),
+				std::make_move_iterator(list.begin()),
+				std::make_move_iterator(list.end())
+			);
+
+		std::sort
+		(
+			all.begin(),
+			all.end(),
+			[](const Folder& a, const Folder& b) { return a.second > b.second; }
+		);
+
+		for (auto& folder : all)
+		{
+			if (tracker.stopped()) return false;
+			if (!std::filesystem::remove(folder.first, error)) return false;
+		}
+
+		return true;
+	}
+
+	static void _sort(QList<Path>& paths)
+	{
+		std::sort
+		(
+			paths.begin(),
+			paths.end(),
+			[](const Path& a, const Path& b) { return a.m_path < b.m_path; }
+		);
+	}
+
+	constexpr static auto SYSTEM_COUNT = Templates + 1;
+
+	constexpr static std::array
+		<
+		std::pair<System, QStandardPaths::StandardLocation>,
+		SYSTEM_COUNT - 1
+		> SYSTEM_TO_QT_TYPE =
 	{
-		static const std::unordered_map
-			<
-			System,
-			QStandardPaths::StandardLocation
-			> map =
 		{
 			{ AppConfig, QStandardPaths::AppConfigLocation },
 			{ AppData, QStandardPaths::AppDataLocation },
@@ -492,38 +1677,629 @@ private:
 			{ Runtime, QStandardPaths::RuntimeLocation },
 			{ Temp, QStandardPaths::TempLocation },
 			{ Templates, QStandardPaths::TemplatesLocation }
-		};
+		}
+	};
+
+	struct SystemCache
+	{
+		std::shared_mutex mutex{};
+		std::array<std::optional<std::filesystem::path>, SYSTEM_COUNT> paths{};
+
+		// The names per-application entries were resolved under. Each entry
+		// records the generation it was resolved in, which moves on whenever
+		// the names change
+		QString organization{};
+		QString application{};
+		std::uint64_t generation = 0;
+		std::array<std::uint64_t, SYSTEM_COUNT> generations{};
+	};
 
-		return map;
+	static SystemCache& _systemCache()
+	{
+		static SystemCache cache{};
+		return cache;
 	}
 
-	std::string _normalizer(const std::string& str, char separator) const
+	constexpr static auto MAX_SYMLINKS = 40;
+	constexpr static std::size_t CANONICAL_CACHE_LIMIT = 1 << 16;
+
+	struct Resolved
+	{
+		std::filesystem::path path{};
+		bool isFolder = false;
+	};
+
+	/// @brief Resolved directories and symlinks, keyed by resolved parent /
+	/// name
+	struct CanonicalCache
 	{
-		std::string normalized{};
-		auto last_ch_was_sep = false;
+		std::shared_mutex mutex{};
 
-		for (auto& ch : str)
+		std::unordered_map
+			<
+			std::filesystem::path::string_type,
+			Resolved
+			> resolved{};
+	};
+
+	static CanonicalCache& _canonicalCache()
+	{
+		static CanonicalCache cache{};
+		return cache;
+	}
+
+	/// @brief Walks path a component at a time from its root, checking the
+	/// cache before the filesystem. Symlinks are resolved recursively (depth
+	/// counts links followed, to stop loops)
+	static std::optional<std::filesystem::path> _resolve
+	(
+		const std::filesystem::path& path,
+		bool weakly,
+		int depth
+	)
+	{
+		auto resolved = _resolveEntry(path, weakly, depth);
+		if (!resolved) return {};
+
+		return std::move(resolved->path);
+	}
+
+	static std::optional<Resolved> _resolveEntry
+	(
+		const std::filesystem::path& path,
+		bool weakly,
+		int depth
+	)
+	{
+		if (depth > MAX_SYMLINKS) return {};
+
+		std::error_code error{};
+		auto absolute = std::filesystem::absolute(path, error);
+		if (error) return {};
+
+		auto& cache = _canonicalCache();
+		Resolved resolved{ absolute.root_path(), true };
+		auto relative = absolute.relative_path();
+
+		for (auto it = relative.begin(); it != relative.end(); ++it)
 		{
-			if (ch == '/' || ch == '\\')
+			auto& part = *it;
+
+			if (part.empty() || part == ".") continue;
+
+			std::optional<Resolved> target{};
+			auto candidate = resolved.path / part;
+
+			// Nothing (not even "..") is found beneath a file
+			if (resolved.isFolder && part == "..")
+				target = Resolved{ resolved.path.parent_path(), true };
+			else if (resolved.isFolder)
 			{
-				if (!last_ch_was_sep)
+				std::shared_lock lock(cache.mutex);
+				auto hit = cache.resolved.find(candidate.native());
+				if (hit != cache.resolved.end()) target = hit->second;
+			}
+
+			if (resolved.isFolder && !target)
+			{
+				auto status = std::filesystem::symlink_status(candidate, error);
+
+				if (!error && std::filesystem::is_symlink(status))
 				{
-					normalized += separator;
-					last_ch_was_sep = true;
+					auto link = std::filesystem::read_symlink(candidate, error);
+
+					if (!error)
+						target = _resolveEntry
+						(
+							link.is_absolute() ? link : resolved.path / link,
+							false,
+							depth + 1
+						);
+				}
+				else if (!error && std::filesystem::exists(status))
+					target = Resolved
+					{
+						candidate,
+						std::filesystem::is_directory(status)
+					};
+
+				if (target && (target->isFolder
+					|| std::filesystem::is_symlink(status)))
+				{
+					std::unique_lock lock(cache.mutex);
+
+					if (cache.resolved.size() >= CANONICAL_CACHE_LIMIT)
+						cache.resolved.clear();
+
+					cache.resolved.emplace(candidate.native(), *target);
 				}
 			}
-			else
+
+			if (!target)
 			{
-				normalized += ch;
-				last_ch_was_sep = false;
+				if (!weakly) return {};
+
+				// Keep the rest as written, but normalized
+				auto rest = resolved.path;
+
+				for (; it != relative.end(); ++it)
+					rest /= *it;
+
+				return Resolved{ rest.lexically_normal(), false };
 			}
+
+			resolved = std::move(*target);
+		}
+
+		return resolved;
+	}
+
+	constexpr static QStandardPaths::StandardLocation _systemToQtType
+	(
+		System type
+	)
+	{
+		for (auto& pair : SYSTEM_TO_QT_TYPE)
+			if (pair.first == type)
+				return pair.second;
+
+		return QStandardPaths::HomeLocation; // Unreachable for valid types
+	}
+
+	static std::filesystem::path _qStandardLocation
+	(
+		QStandardPaths::StandardLocation type
+	)
+	{
+		return QStandardPaths::locate
+		(
+			type,
+			{},
+			QStandardPaths::LocateDirectory
+		).toStdString();
+	}
+
+	/// @brief The locations Qt derives from the organization and application
+	/// names
+	static bool _isPerApplication(System type)
+	{
+		return type == AppConfig
+			|| type == AppData
+			|| type == AppLocalData
+			|| type == Cache;
+	}
+
+	/// @brief Whether the names per-application entries were resolved under
+	/// are still current. Compares Qt's shared strings; nothing is built
+	static bool _isCurrentApp(const SystemCache& cache)
+	{
+		return cache.organization == QCoreApplication::organizationName()
+			&& cache.application == QCoreApplication::applicationName();
+	}
+
+	/// @brief Resolves through the cache, only asking Qt (which touches the
+	/// filesystem) the first time each location is requested
+	/// @details A location that doesn't exist is cached too, as an empty
+	/// path, so asking for a missing folder doesn't touch the filesystem
+	/// every time; call invalidateSystemCache() after creating it.
+	/// Per-application locations are cached with the names they were resolved
+	/// under, so a lookup made before setApplicationName() isn't returned
+	/// after it
+	static std::filesystem::path _fromSystem(System type)
+	{
+		if (type < 0 || type >= SYSTEM_COUNT) return {};
+
+		auto& cache = _systemCache();
+		auto per_app = _isPerApplication(type);
+
+		{
+			std::shared_lock lock(cache.mutex);
+			auto& path = cache.paths[type];
+
+			if (path && (!per_app || (_isCurrentApp(cache)
+				&& cache.generations[type] == cache.generation)))
+				return *path;
+		}
+
+		// Read before resolving, so the entry is tagged with the names Qt
+		// actually used
+		auto organization = QCoreApplication::organizationName();
+		auto application = QCoreApplication::applicationName();
+
+		auto path = (type == Root)
+			? std::filesystem::path(QDir::rootPath().toStdString())
+			: _qStandardLocation(_systemToQtType(type));
+
+		std::unique_lock lock(cache.mutex);
+
+		if (per_app && (cache.organization != organization
+			|| cache.application != application))
+		{
+			cache.organization = std::move(organization);
+			cache.application = std::move(application);
+			++cache.generation;
 		}
 
-		return normalized;
+		cache.paths[type] = path;
+		cache.generations[type] = cache.generation;
+
+		return path;
+	}
+
+	std::string _normalizer(char separator) const
+	{
+		if constexpr (NARROW_NATIVE)
+		{
+			auto& native = m_path.native();
+			std::string normalized(native.size(), '\0');
+
+			normalized.resize
+			(
+				PathNormalizer::normalize
+				(
+					native.data(),
+					native.size(),
+					normalized.data(),
+					separator
+				)
+			);
+
+			return normalized;
+		}
+		else
+		{
+			// Wide native strings (Windows) convert first, then normalize in
+			// place
+			auto string = m_path.string();
+
+			string.resize
+			(
+				PathNormalizer::normalize
+				(
+					string.data(),
+					string.size(),
+					string.data(),
+					separator
+				)
+			);
+
+			return string;
+		}
 	}
 
 }; // class Path
 
+/// @brief Totals for one directory and everything beneath it
+struct Path::DiskUsage
+{
+	Path path{};
+	int depth = 0; // Below the Path diskUsage() was called on
+	std::uint64_t apparent = 0; // Sum of sizes
+	std::uint64_t allocated = 0; // Sum of blocks on disk
+	std::uint64_t files = 0; // Non-directory entries
+};
+
+inline QList<Path::DiskUsage> Path::diskUsage
+(
+	int maxDepth,
+	int threadCount
+)
+	const
+{
+	PathFileOps::Entry root{};
+	if (!PathFileOps::stat(m_path, root)) return {};
+
+	if (!root.isFolder)
+		return { { *this, 0, root.size, root.allocated, 1 } };
+
+	struct Job
+	{
+		std::filesystem::path path{};
+		std::size_t parent = 0;
+		int depth = 0;
+		std::uint64_t apparent = 0;
+		std::uint64_t allocated = 0;
+	};
+
+	struct Node
+	{
+		std::size_t id = 0;
+		std::size_t parent = 0;
+		int depth = 0;
+		std::filesystem::path path{};
+		std::uint64_t apparent = 0;
+		std::uint64_t allocated = 0;
+		std::uint64_t files = 0;
+	};
+
+	std::vector<std::vector<Node>> nodes(PathWorkers::count(threadCount));
+	std::atomic<std::size_t> next_id{ 0 };
+	std::set<std::pair<std::uint64_t, std::uint64_t>> linked{};
+	std::mutex linked_mutex{};
+
+	// A second sighting of a hard-linked inode counts nothing
+	auto is_first_link = [&](const PathFileOps::Entry& entry)
+		{
+			if (entry.links < 2 || entry.inode == 0) return true;
+
+			std::lock_guard lock(linked_mutex);
+			return linked.emplace(entry.device, entry.inode).second;
+		};
+
+	PathWorkers::run<Job>
+	(
+		{ { m_path, 0, 0, root.size, root.allocated } },
+		[&](int worker, Job job, auto push)
+		{
+			// Parents get ids before their children are queued, so a
+			// child's id is always greater than its parent's
+			Node node{};
+			node.id = next_id.fetch_add(1, std::memory_order_relaxed);
+			node.parent = job.parent;
+			node.depth = job.depth;
+			node.apparent = job.apparent;
+			node.allocated = job.allocated;
+
+			PathFileOps::list
+			(
+				job.path,
+				[&](const PathFileOps::Entry& entry)
+				{
+					if (entry.isFolder)
+					{
+						push
+						({
+							entry.path,
+							node.id,
+							job.depth + 1,
+							entry.size,
+							entry.allocated
+						});
+
+						return;
+					}
+
+					if (!is_first_link(entry)) return;
+
+					node.apparent += entry.size;
+					node.allocated += entry.allocated;
+					++node.files;
+				}
+			);
+
+			node.path = std::move(job.path);
+			nodes[worker].push_back(std::move(node));
+		},
+		threadCount
+	);
+
+	std::vector<Node> all(next_id.load());
+
+	for (auto& list : nodes)
+		for (auto& node : list)
+			all[node.id] = std::move(node);
+
+	for (auto i = all.size(); i-- > 1; )
+	{
+		auto& parent = all[all[i].parent];
+		parent.apparent += all[i].apparent;
+		parent.allocated += all[i].allocated;
+		parent.files += all[i].files;
+	}
+
+	QList<DiskUsage> usage{};
+
+	for (auto& node : all)
+		if (maxDepth < 0 || node.depth <= maxDepth)
+			usage.push_back
+			({
+				Path(node.path),
+				node.depth,
+				node.apparent,
+				node.allocated,
+				node.files
+			});
+
+	std::sort
+	(
+		usage.begin(),
+		usage.end(),
+		[](const DiskUsage& a, const DiskUsage& b)
+		{
+			return a.path.m_path < b.path.m_path;
+		}
+	);
+
+	return usage;
+}
+
+/// @brief A read-only mapping of a file from Path::map. The file stays
+/// mapped until the Mapping is destroyed
+/// @details An empty file is a valid, empty Mapping; one that can't be
+/// opened or mapped is invalid (false)
+class Path::Mapping
+{
+public:
+	Mapping() = default;
+
+	Mapping(const Path& path, Access access)
+		: m_file(std::make_unique<QFile>(path.toQString()))
+	{
+		if (!m_file->open(QIODevice::ReadOnly)) return;
+
+		auto size = m_file->size();
+
+		if (size == 0)
+		{
+			m_valid = true;
+			return;
+		}
+
+		// Unmapped when m_file is destroyed
+		auto data = m_file->map(0, size);
+		if (!data) return;
+
+		m_data = reinterpret_cast<const std::byte*>(data);
+		m_size = static_cast<std::size_t>(size);
+		m_valid = true;
+
+		advise(access);
+	}
+
+	Mapping(const Mapping&) = delete;
+	Mapping& operator=(const Mapping&) = delete;
+	Mapping(Mapping&& other) noexcept
+		: m_file(std::move(other.m_file))
+		, m_data(std::exchange(other.m_data, nullptr))
+		, m_size(std::exchange(other.m_size, 0))
+		, m_valid(std::exchange(other.m_valid, false))
+	{
+	}
+
+	Mapping& operator=(Mapping&& other) noexcept
+	{
+		if (this != &other)
+		{
+			m_file = std::move(other.m_file);
+			m_data = std::exchange(other.m_data, nullptr);
+			m_size = std::exchange(other.m_size, 0);
+			m_valid = std::exchange(other.m_valid, false);
+		}
+
+		return *this;
+	}
+
+	explicit operator bool() const { return m_valid; }
+	bool isEmpty() const { return m_size == 0; }
+
+	const std::byte* data() const { return m_data; }
+	std::size_t size() const { return m_size; }
+
+	std::span<const std::byte> span() const { return { m_data, m_size }; }
+
+	QByteArrayView view() const
+	{
+		return { m_data, static_cast<qsizetype>(m_size) };
+	}
+
+	/// @brief Changes the access hint for the mapped range
+	void advise(Access access) const
+	{
+#ifdef Q_OS_LINUX
+		if (!m_data) return;
+
+		auto advice = MADV_NORMAL;
+
+		switch (access)
+		{
+		case Access::Normal: advice = MADV_NORMAL; break;
+		case Access::Sequential: advice = MADV_SEQUENTIAL; break;
+		case Access::Random: advice = MADV_RANDOM; break;
+		}
+
+		// Offset 0 maps from the start of a page, as madvise requires
+		::madvise(const_cast<std::byte*>(m_data), m_size, advice);
+#else
+		(void)access;
+#endif
+	}
+
+private:
+	std::unique_ptr<QFile> m_file{};
+	const std::byte* m_data = nullptr;
+	std::size_t m_size = 0;
+	bool m_valid = false;
+
+}; // class Path::Mapping
+
+inline Path::Mapping Path::map(Access access) const
+{
+	return Mapping(*this, access);
+}
+
+/// @brief A single-pass range over the results of Path::walk. The directory
+/// is read as the range is iterated, not up front
+/// @details Iterators point into the Walk, so keep it alive (and in place)
+/// while iterating
+class Path::Walk
+{
+public:
+	class Iterator
+	{
+	public:
+		using iterator_category = std::input_iterator_tag;
+		using value_type = Path;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const Path*;
+		using reference = const Path&;
+
+		Iterator() = default;
+		explicit Iterator(Walk* walk) : m_walk(walk) { _advance(); }
+
+		reference operator*() const { return m_walk->m_current; }
+		pointer operator->() const { return &m_walk->m_current; }
+
+		Iterator& operator++()
+		{
+			_advance();
+			return *this;
+		}
+
+		void operator++(int) { _advance(); }
+
+		bool operator==(std::default_sentinel_t) const { return !m_walk; }
+
+	private:
+		Walk* m_walk = nullptr;
+
+		void _advance()
+		{
+			if (m_walk && !m_walk->_next())
+				m_walk = nullptr;
+		}
+
+	}; // class Path::Walk::Iterator
+
+	Walk
+	(
+		const Path& directory,
+		const QString& extension,
+		Recursive recursive = Recursive::Yes
+	)
+		: m_iterator
+		(
+			new QDirIterator(_extensionIterator(directory, extension, recursive))
+		)
+	{
+	}
+
+	Iterator begin() { return Iterator(this); }
+	std::default_sentinel_t end() const { return {}; }
+
+private:
+	std::unique_ptr<QDirIterator> m_iterator;
+	Path m_current{};
+
+	bool _next()
+	{
+		if (!m_iterator->hasNext()) return false;
+
+		m_current = m_iterator->next();
+		return true;
+	}
+
+}; // class Path::Walk
+
+inline Path::Walk Path::walk
+(
+	const Path& directory,
+	const QString& extension,
+	Recursive recursive
+)
+{
+	return Walk(directory, extension, recursive);
+}
+
 // Provides std::hash compatibility
 std::size_t std::hash<Path>::operator()(const Path& path) const
 {
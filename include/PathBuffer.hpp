@@ -0,0 +1,275 @@
+#pragma once
+
+/*
+* cc/PathBuffer.hpp  Copyright (C) 2026  fairybow
+*
+* You should have received a copy of the GNU General Public License along with
+* this program. If not, see <https://www.gnu.org/licenses/>.
+*
+* This file uses Qt 6. Qt is a free and open-source widget toolkit for creating
+* graphical user interfaces. For more information, visit <https://www.qt.io/>.
+*
+* Updated: 2026-10-16
+*/
+
+#include "Path.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <memory_resource>
+#include <string_view>
+
+/// @brief An allocation-light scratch path for hot building loops. Short
+/// paths live in an inline buffer; longer ones spill to a std::pmr memory
+/// resource (e.g., a std::pmr::monotonic_buffer_resource arena)
+/// @details Decomposition returns views into the buffer and parent() trims in
+/// place, so neither allocates. Convert with toPath() once the path is built
+template <std::size_t InlineSize = 256>
+class BasicPathBuffer
+{
+public:
+	using value_type = std::filesystem::path::value_type;
+	using view_type = std::basic_string_view<value_type>;
+
+	explicit BasicPathBuffer
+	(
+		std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+	)
+		: m_resource(resource)
+	{
+	}
+
+	BasicPathBuffer
+	(
+		view_type path,
+		std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+	)
+		: m_resource(resource)
+	{
+		append(path);
+	}
+
+	BasicPathBuffer(const BasicPathBuffer& other)
+		: m_resource(other.m_resource)
+	{
+		append(other.view());
+	}
+
+	BasicPathBuffer& operator=(const BasicPathBuffer& other)
+	{
+		if (this != &other)
+		{
+			clear();
+			append(other.view());
+		}
+
+		return *this;
+	}
+
+	/// @brief Takes other's spilled storage, or copies its inline characters.
+	/// Leaves other empty
+	BasicPathBuffer(BasicPathBuffer&& other) noexcept
+		: m_resource(other.m_resource)
+	{
+		_take(other);
+	}
+
+	/// @brief As the move constructor, but spilled storage is only taken if
+	/// both buffers use the same memory resource (otherwise it's copied)
+	BasicPathBuffer& operator=(BasicPathBuffer&& other)
+	{
+		if (this == &other) return *this;
+
+		if (other.isInline() || *m_resource != *other.m_resource)
+		{
+			clear();
+			append(other.view());
+			other.clear();
+		}
+		else
+		{
+			_release();
+			_take(other);
+		}
+
+		return *this;
+	}
+
+	~BasicPathBuffer() { _release(); }
+
+	view_type view() const { return { m_data, m_size }; }
+	std::size_t size() const { return m_size; }
+	bool isEmpty() const { return m_size == 0; }
+	bool isInline() const { return m_data == m_inline; }
+
+	void clear() noexcept { m_size = 0; }
+
+	/// @brief Raw concatenation, like Path::operator+=
+	BasicPathBuffer& append(view_type text)
+	{
+		_reserve(m_size + text.size());
+		std::copy(text.begin(), text.end(), m_data + m_size);
+		m_size += text.size();
+
+		return *this;
+	}
+
+	BasicPathBuffer& operator+=(view_type text) { return append(text); }
+
+	/// @brief Joins with a separator, like Path::operator/=. An absolute
+	/// part replaces the buffer, as it would for std::filesystem::path
+	BasicPathBuffer& operator/=(view_type part)
+	{
+		if (!part.empty() && Path::isSeparator(part.front()))
+			clear();
+		else if (m_size > 0 && !Path::isSeparator(m_data[m_size - 1]))
+		{
+			value_type separator = std::filesystem::path::preferred_separator;
+			append({ &separator, 1 });
+		}
+
+		return append(part);
+	}
+
+	// Decomposition (views into the buffer):
+
+	view_type file() const
+	{
+		auto text = view();
+		auto separator = _lastSeparator(text);
+
+		return separator == view_type::npos
+			? text
+			: text.substr(separator + 1);
+	}
+
+	view_type parentView() const
+	{
+		auto text = view();
+		auto separator = _lastSeparator(text);
+		if (separator == view_type::npos) return {};
+
+		// Keep a lone root ("/") but drop redundant trailing separators
+		auto end = separator;
+		while (end > 0 && Path::isSeparator(text[end - 1])) --end;
+
+		return text.substr(0, end == 0 ? 1 : end);
+	}
+
+	view_type stem() const
+	{
+		auto name = file();
+		auto dot = _extensionDot(name);
+
+		return dot == view_type::npos ? name : name.substr(0, dot);
+	}
+
+	view_type extension() const
+	{
+		auto name = file();
+		auto dot = _extensionDot(name);
+
+		return dot == view_type::npos ? view_type{} : name.substr(dot);
+	}
+
+	// Modification:
+
+	/// @brief Trims to the parent in place
+	BasicPathBuffer& parent()
+	{
+		m_size = parentView().size();
+		return *this;
+	}
+
+	// Conversion:
+
+	Path toPath() const { return std::filesystem::path(view()); }
+
+private:
+	constexpr static value_type DOT = value_type('.');
+
+	std::pmr::memory_resource* m_resource;
+	value_type m_inline[InlineSize]; // Left uninitialized: m_size bounds reads
+	value_type* m_data = m_inline;
+	std::size_t m_size = 0;
+	std::size_t m_capacity = InlineSize;
+
+	static std::size_t _lastSeparator(view_type text)
+	{
+		for (auto i = text.size(); i > 0; --i)
+			if (Path::isSeparator(text[i - 1])) return i - 1;
+
+		return view_type::npos;
+	}
+
+	// Matches std::filesystem: "." and ".." and dotfiles have no extension
+	static std::size_t _extensionDot(view_type name)
+	{
+		if (name.empty()) return view_type::npos;
+		if (name.size() == 1 && name[0] == DOT) return view_type::npos;
+		if (name.size() == 2 && name[0] == DOT && name[1] == DOT)
+			return view_type::npos;
+
+		auto dot = name.rfind(DOT);
+		return (dot == 0) ? view_type::npos : dot;
+	}
+
+	void _reserve(std::size_t needed)
+	{
+		if (needed <= m_capacity) return;
+
+		auto capacity = std::max(needed, m_capacity * 2);
+		auto data = static_cast<value_type*>
+		(
+			m_resource->allocate
+			(
+				capacity * sizeof(value_type),
+				alignof(value_type)
+			)
+		);
+
+		std::copy(m_data, m_data + m_size, data);
+		_release();
+
+		m_data = data;
+		m_capacity = capacity;
+	}
+
+	/// @brief Moves other's contents into this (empty, inline) buffer, which
+	/// must share other's resource
+	void _take(BasicPathBuffer& other) noexcept
+	{
+		if (other.isInline())
+			std::copy(other.m_data, other.m_data + other.m_size, m_inline);
+		else
+		{
+			m_data = other.m_data;
+			m_capacity = other.m_capacity;
+
+			other.m_data = other.m_inline;
+			other.m_capacity = InlineSize;
+		}
+
+		m_size = other.m_size;
+		other.m_size = 0;
+	}
+
+	void _release()
+	{
+		if (isInline()) return;
+
+		m_resource->deallocate
+		(
+			m_data,
+			m_capacity * sizeof(value_type),
+			alignof(value_type)
+		);
+
+		m_data = m_inline;
+		m_capacity = InlineSize;
+	}
+
+}; // class BasicPathBuffer
+
+using PathBuffer = BasicPathBuffer<>;
@@ -0,0 +1,233 @@
+#pragma once
+
+/*
+* cc/PathDigest.hpp  Copyright (C) 2026  fairybow
+*
+* You should have received a copy of the GNU General Public License along with
+* this program. If not, see <https://www.gnu.org/licenses/>.
+*
+* Updated: 2026-10-16
+*/
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/// @brief Streaming content hash for Path::fingerprint: XXH64, optionally
+/// run with a second seed in the same pass for a 128-bit digest
+/// @details The low half is plain XXH64 (seed 0), so 64-bit digests match
+/// other xxHash tools. The high half is XXH64 with HIGH_SEED. Not
+/// cryptographic: for dedup and change detection only
+namespace PathDigest
+{
+	enum class Wide { No = 0, Yes };
+
+	struct Digest
+	{
+		std::uint64_t low = 0;
+		std::uint64_t high = 0; // Zero unless Wide::Yes
+
+		bool operator==(const Digest&) const = default;
+	};
+
+	namespace Detail
+	{
+		constexpr std::uint64_t PRIME_1 = 0x9E3779B185EBCA87ULL;
+		constexpr std::uint64_t PRIME_2 = 0xC2B2AE3D27D4EB4FULL;
+		constexpr std::uint64_t PRIME_3 = 0x165667B19E3779F9ULL;
+		constexpr std::uint64_t PRIME_4 = 0x85EBCA77C2B2AE63ULL;
+		constexpr std::uint64_t PRIME_5 = 0x27D4EB2F165667C5ULL;
+
+		constexpr std::uint64_t HIGH_SEED = 0x9E3779B97F4A7C15ULL;
+		constexpr std::size_t STRIPE = 32;
+
+		constexpr std::uint64_t rotl(std::uint64_t value, int bits)
+		{
+			return (value << bits) | (value >> (64 - bits));
+		}
+
+		constexpr std::uint64_t round(std::uint64_t acc, std::uint64_t input)
+		{
+			return rotl(acc + input * PRIME_2, 31) * PRIME_1;
+		}
+
+		constexpr std::uint64_t merge(std::uint64_t acc, std::uint64_t value)
+		{
+			return (acc ^ round(0, value)) * PRIME_1 + PRIME_4;
+		}
+
+		// Little-endian loads, as XXH64 defines them
+		inline std::uint64_t read64(const unsigned char* data)
+		{
+			std::uint64_t value = 0;
+
+			for (auto i = 0; i < 8; ++i)
+				value |= std::uint64_t(data[i]) << (8 * i);
+
+			return value;
+		}
+
+		inline std::uint32_t read32(const unsigned char* data)
+		{
+			std::uint32_t value = 0;
+
+			for (auto i = 0; i < 4; ++i)
+				value |= std::uint32_t(data[i]) << (8 * i);
+
+			return value;
+		}
+
+		struct Lane
+		{
+			std::array<std::uint64_t, 4> acc{};
+			std::uint64_t seed;
+
+			explicit Lane(std::uint64_t seed = 0)
+				: acc
+				{
+					seed + PRIME_1 + PRIME_2,
+					seed + PRIME_2,
+					seed,
+					seed - PRIME_1
+				}
+				, seed(seed)
+			{
+			}
+
+			void stripe(const unsigned char* data)
+			{
+				for (auto i = 0; i < 4; ++i)
+					acc[i] = round(acc[i], read64(data + 8 * i));
+			}
+
+			std::uint64_t finish
+			(
+				std::uint64_t total,
+				const unsigned char* tail,
+				std::size_t tailSize
+			)
+				const
+			{
+				std::uint64_t hash = 0;
+
+				if (total >= STRIPE)
+				{
+					hash = rotl(acc[0], 1) + rotl(acc[1], 7)
+						+ rotl(acc[2], 12) + rotl(acc[3], 18);
+
+					for (auto value : acc)
+						hash = merge(hash, value);
+				}
+				else
+					hash = seed + PRIME_5;
+
+				hash += total;
+
+				std::size_t i = 0;
+
+				for (; i + 8 <= tailSize; i += 8)
+					hash = rotl(hash ^ round(0, read64(tail + i)), 27)
+						* PRIME_1 + PRIME_4;
+
+				if (i + 4 <= tailSize)
+				{
+					hash = rotl(hash ^ (read32(tail + i) * PRIME_1), 23)
+						* PRIME_2 + PRIME_3;
+					i += 4;
+				}
+
+				for (; i < tailSize; ++i)
+					hash = rotl(hash ^ (tail[i] * PRIME_5), 11) * PRIME_1;
+
+				hash ^= hash >> 33;
+				hash *= PRIME_2;
+				hash ^= hash >> 29;
+				hash *= PRIME_3;
+				hash ^= hash >> 32;
+
+				return hash;
+			}
+		};
+
+	} // namespace PathDigest::Detail
+
+	/// @brief Feed bytes in any split with update(); digest() doesn't
+	/// consume the state, so it can be read mid-stream
+	class Hasher
+	{
+	public:
+		explicit Hasher(Wide wide = Wide::Yes)
+			: m_wide(wide == Wide::Yes)
+			, m_high(Detail::HIGH_SEED)
+		{
+		}
+
+		void update(const void* data, std::size_t size)
+		{
+			auto bytes = static_cast<const unsigned char*>(data);
+			m_total += size;
+
+			// Top up a partial stripe left by the last call first
+			if (m_tailSize > 0)
+			{
+				auto fill = std::min(Detail::STRIPE - m_tailSize, size);
+				std::memcpy(m_tail.data() + m_tailSize, bytes, fill);
+
+				m_tailSize += fill;
+				bytes += fill;
+				size -= fill;
+
+				if (m_tailSize < Detail::STRIPE) return;
+
+				_stripe(m_tail.data());
+				m_tailSize = 0;
+			}
+
+			for (; size >= Detail::STRIPE; size -= Detail::STRIPE)
+			{
+				_stripe(bytes);
+				bytes += Detail::STRIPE;
+			}
+
+			std::memcpy(m_tail.data(), bytes, size);
+			m_tailSize = size;
+		}
+
+		Digest digest() const
+		{
+			Digest digest{};
+			digest.low = m_low.finish(m_total, m_tail.data(), m_tailSize);
+
+			if (m_wide)
+				digest.high = m_high.finish(m_total, m_tail.data(), m_tailSize);
+
+			return digest;
+		}
+
+	private:
+		bool m_wide;
+		Detail::Lane m_low{};
+		Detail::Lane m_high;
+		std::uint64_t m_total = 0;
+		std::array<unsigned char, Detail::STRIPE> m_tail{};
+		std::size_t m_tailSize = 0;
+
+		void _stripe(const unsigned char* data)
+		{
+			m_low.stripe(data);
+			if (m_wide) m_high.stripe(data);
+		}
+
+	}; // class PathDigest::Hasher
+
+	inline Digest of(const void* data, std::size_t size, Wide wide = Wide::Yes)
+	{
+		Hasher hasher(wide);
+		hasher.update(data, size);
+
+		return hasher.digest();
+	}
+
+} // namespace PathDigest
@@ -0,0 +1,351 @@
+#pragma once
+
+/*
+* cc/PathFileOps.hpp  Copyright (C) 2026  fairybow
+*
+* You should have received a copy of the GNU General Public License along with
+* this program. If not, see <https://www.gnu.org/licenses/>.
+*
+* Updated: 2026-10-16
+*/
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <system_error>
+
+#if defined(__linux__)
+#include <dirent.h>
+#include <fcntl.h>
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <string_view>
+#include <vector>
+#endif
+
+/// @brief Single-file primitives for Path's tree operations. On Linux a copy
+/// tries a reflink (FICLONE) first, then copy_file_range, then a buffered
+/// read/write loop; a rename won't replace an existing target; and listing a
+/// directory stats each entry once, relative to the open directory
+namespace PathFileOps
+{
+	namespace Detail
+	{
+#if defined(__linux__)
+
+		constexpr std::size_t BUFFER_SIZE = 1 << 20;
+
+		/// @brief Closes the descriptor on scope exit
+		struct Fd
+		{
+			int fd = -1;
+
+			explicit Fd(int descriptor) : fd(descriptor) {}
+			~Fd() { if (fd >= 0) ::close(fd); }
+
+			Fd(const Fd&) = delete;
+			Fd& operator=(const Fd&) = delete;
+		};
+
+		inline bool buffered(int in, int out, std::uint64_t& bytes)
+		{
+			std::vector<char> buffer(BUFFER_SIZE);
+
+			while (true)
+			{
+				auto read = ::read(in, buffer.data(), buffer.size());
+				if (read < 0 && errno == EINTR) continue;
+				if (read < 0) return false;
+				if (read == 0) return true;
+
+				for (ssize_t done = 0; done < read; )
+				{
+					auto written = ::write(out, buffer.data() + done, read - done);
+					if (written < 0 && errno == EINTR) continue;
+					if (written < 0) return false;
+
+					done += written;
+				}
+
+				bytes += static_cast<std::uint64_t>(read);
+			}
+		}
+
+		/// @brief Returns false with errno set if the kernel path isn't
+		/// available for these files (so the caller can fall back). Returns
+		/// true with bytes short of size if it stopped early, which the
+		/// caller also finishes another way
+		inline bool copyRange
+		(
+			int in,
+			int out,
+			std::uint64_t size,
+			std::uint64_t& bytes
+		)
+		{
+			while (bytes < size)
+			{
+				auto copied = ::copy_file_range
+				(
+					in,
+					nullptr,
+					out,
+					nullptr,
+					static_cast<std::size_t>(size - bytes),
+					0
+				);
+
+				if (copied < 0 && errno == EINTR) continue;
+				if (copied < 0) return false;
+				if (copied == 0) break; // Shrank, or the filesystem reports 0
+
+				bytes += static_cast<std::uint64_t>(copied);
+			}
+
+			return true;
+		}
+
+#endif // defined(__linux__)
+
+	} // namespace PathFileOps::Detail
+
+	/// @brief Copies one regular file, replacing any file at to. Adds the
+	/// bytes copied to bytes
+	/// @details An existing entry at to is unlinked rather than written
+	/// through, so a symlink there is replaced, not followed out of the
+	/// destination. If something recreates to in between, the copy fails
+	inline bool copyFile
+	(
+		const std::filesystem::path& from,
+		const std::filesystem::path& to,
+		std::uint64_t& bytes
+	)
+	{
+#if defined(__linux__)
+		Detail::Fd in(::open(from.c_str(), O_RDONLY | O_CLOEXEC));
+		if (in.fd < 0) return false;
+
+		struct stat info{};
+		if (::fstat(in.fd, &info) != 0) return false;
+
+		if (::unlink(to.c_str()) != 0 && errno != ENOENT) return false;
+
+		Detail::Fd out
+		(
+			::open
+			(
+				to.c_str(),
+				O_WRONLY | O_CREAT | O_EXCL | O_NOFOLLOW | O_CLOEXEC,
+				info.st_mode & 07777
+			)
+		);
+
+		if (out.fd < 0) return false;
+
+		auto size = static_cast<std::uint64_t>(info.st_size);
+
+		// Reflink: shares extents on CoW filesystems (Btrfs, XFS, ...)
+		if (::ioctl(out.fd, FICLONE, in.fd) == 0)
+		{
+			bytes += size;
+			return true;
+		}
+
+		std::uint64_t copied = 0;
+		auto ok = Detail::copyRange(in.fd, out.fd, size, copied);
+
+		auto unsupported = !ok && copied == 0
+			&& (errno == EXDEV || errno == ENOSYS || errno == EINVAL
+				|| errno == EOPNOTSUPP);
+
+		// Also finish with plain reads if copy_file_range stopped short or
+		// the size was 0 (pseudo-files such as /proc report that). The file
+		// offsets are where it left them, so this carries on to end of file
+		if (unsupported || (ok && (copied < size || size == 0)))
+			ok = Detail::buffered(in.fd, out.fd, copied);
+
+		bytes += copied;
+		return ok;
+#else
+		std::error_code error{};
+		auto existing = std::filesystem::symlink_status(to, error);
+
+		if (std::filesystem::exists(existing)
+			&& !std::filesystem::is_directory(existing)
+			&& !std::filesystem::remove(to, error))
+			return false;
+
+		if (!std::filesystem::copy_file(from, to, error))
+			return false;
+
+		auto size = std::filesystem::file_size(to, error);
+		if (!error) bytes += size;
+
+		return true;
+#endif
+	}
+
+	enum class Rename { Done = 0, CrossDevice, Failed };
+
+	/// @brief Renames from to to in one step if they're on the same
+	/// filesystem, without replacing an existing target
+	inline Rename rename
+	(
+		const std::filesystem::path& from,
+		const std::filesystem::path& to
+	)
+	{
+#if defined(__linux__)
+		auto renamed = ::renameat2
+		(
+			AT_FDCWD,
+			from.c_str(),
+			AT_FDCWD,
+			to.c_str(),
+			RENAME_NOREPLACE
+		);
+
+		if (renamed == 0) return Rename::Done;
+
+		if (errno == EXDEV) return Rename::CrossDevice;
+
+		// Filesystems without RENAME_NOREPLACE: check, then plain rename
+		if (errno != EINVAL && errno != ENOSYS) return Rename::Failed;
+#endif
+
+		std::error_code error{};
+		if (std::filesystem::exists(to, error)) return Rename::Failed;
+
+		std::filesystem::rename(from, to, error);
+
+		if (!error) return Rename::Done;
+
+		return error == std::errc::cross_device_link
+			? Rename::CrossDevice
+			: Rename::Failed;
+	}
+
+	/// @brief One directory entry's metadata, without following symlinks.
+	/// Allocated is the space the entry occupies on disk; device, inode, and
+	/// links are zero where the platform doesn't provide them, and mtime's
+	/// epoch is the platform's file clock
+	struct Entry
+	{
+		std::filesystem::path path{};
+		bool isFolder = false;
+		std::uint64_t size = 0;
+		std::uint64_t allocated = 0;
+		std::int64_t mtime = 0; // Nanoseconds; compare, don't convert
+		std::uint64_t device = 0;
+		std::uint64_t inode = 0;
+		std::uint64_t links = 0;
+	};
+
+	inline bool stat(const std::filesystem::path& path, Entry& entry)
+	{
+		entry = {};
+		entry.path = path;
+
+#if defined(__linux__)
+		struct stat info{};
+		if (::lstat(path.c_str(), &info) != 0) return false;
+
+		entry.isFolder = S_ISDIR(info.st_mode);
+		entry.size = static_cast<std::uint64_t>(info.st_size);
+		entry.allocated = static_cast<std::uint64_t>(info.st_blocks) * 512;
+		entry.mtime = std::int64_t(info.st_mtim.tv_sec) * 1'000'000'000
+			+ info.st_mtim.tv_nsec;
+		entry.device = info.st_dev;
+		entry.inode = info.st_ino;
+		entry.links = info.st_nlink;
+#else
+		std::error_code error{};
+		auto status = std::filesystem::symlink_status(path, error);
+		if (error) return false;
+
+		entry.isFolder = std::filesystem::is_directory(status);
+
+		auto written = std::filesystem::last_write_time(path, error);
+
+		if (!error)
+			entry.mtime = std::chrono::duration_cast<std::chrono::nanoseconds>
+			(
+				written.time_since_epoch()
+			).count();
+
+		if (std::filesystem::is_regular_file(status))
+		{
+			auto size = std::filesystem::file_size(path, error);
+			if (!error) entry.size = entry.allocated = size;
+		}
+#endif
+
+		return true;
+	}
+
+	/// @brief Calls func(entry) for each entry in folder (not "." or "..").
+	/// Returns false if the folder couldn't be read
+	template <typename FuncT>
+	bool list(const std::filesystem::path& folder, FuncT func)
+	{
+#if defined(__linux__)
+		auto fd = ::open(folder.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+		if (fd < 0) return false;
+
+		// Owns fd from here on
+		auto dir = ::fdopendir(fd);
+
+		if (!dir)
+		{
+			::close(fd);
+			return false;
+		}
+
+		Entry entry{};
+
+		while (auto item = ::readdir(dir))
+		{
+			std::string_view name = item->d_name;
+			if (name == "." || name == "..") continue;
+
+			struct stat info{};
+			if (::fstatat(fd, item->d_name, &info, AT_SYMLINK_NOFOLLOW) != 0)
+				continue;
+
+			entry.path = folder / name;
+			entry.isFolder = S_ISDIR(info.st_mode);
+			entry.size = static_cast<std::uint64_t>(info.st_size);
+			entry.allocated = static_cast<std::uint64_t>(info.st_blocks) * 512;
+			entry.mtime = std::int64_t(info.st_mtim.tv_sec) * 1'000'000'000
+				+ info.st_mtim.tv_nsec;
+			entry.device = info.st_dev;
+			entry.inode = info.st_ino;
+			entry.links = info.st_nlink;
+
+			func(entry);
+		}
+
+		::closedir(dir);
+		return true;
+#else
+		std::error_code error{};
+		std::filesystem::directory_iterator it(folder, error);
+		if (error) return false;
+
+		Entry entry{};
+
+		for (; !error && it != std::filesystem::directory_iterator{};
+			it.increment(error))
+			if (stat(it->path(), entry))
+				func(entry);
+
+		return true;
+#endif
+	}
+
+} // namespace PathFileOps
@@ -0,0 +1,185 @@
+#pragma once
+
+/*
+* cc/PathFingerprint.hpp  Copyright (C) 2026  fairybow
+*
+* You should have received a copy of the GNU General Public License along with
+* this program. If not, see <https://www.gnu.org/licenses/>.
+*
+* This file uses Qt 6. Qt is a free and open-source widget toolkit for creating
+* graphical user interfaces. For more information, visit <https://www.qt.io/>.
+*
+* Updated: 2026-10-16
+*/
+
+#include "Path.hpp"
+#include "PathDigest.hpp"
+#include "PathInfo.hpp"
+#include "PathWorkers.hpp"
+
+#include <QList>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <unordered_map>
+
+/// @brief Fingerprints many files at once across a thread pool, optionally
+/// remembering digests so files that haven't changed aren't read again
+/// @details Files are spread across workers, one file per task; each file is
+/// still read start to end by one worker. A cached digest is reused while the
+/// file's (device, inode, size, mtime) are unchanged. Off Linux, where there
+/// is no inode, entries are keyed by path instead
+class PathFingerprint
+{
+public:
+	using Digest = PathDigest::Digest;
+	using Wide = PathDigest::Wide;
+
+	/// @brief Fingerprints every path, keeping input order. Unreadable files
+	/// give an empty optional
+	static QList<std::optional<Digest>> of
+	(
+		const QList<Path>& paths,
+		Wide wide = Wide::Yes,
+		int threadCount = 0
+	)
+	{
+		return _batch
+		(
+			paths,
+			threadCount,
+			[&](const Path& path) { return path.fingerprint(wide); }
+		);
+	}
+
+	/// @brief Fingerprints one path, through the cache
+	std::optional<Digest> cached(const Path& path, Wide wide = Wide::Yes)
+	{
+		auto info = PathInfo::of(path);
+		if (!info.isFile()) return {};
+
+		auto key = _key(path, info);
+
+		{
+			std::shared_lock lock(m_mutex);
+			auto it = m_entries.find(key);
+
+			if (it != m_entries.end() && _isFresh(it->second, info, wide))
+			{
+				auto digest = it->second.digest;
+				if (wide == Wide::No) digest.high = 0;
+
+				return digest;
+			}
+		}
+
+		auto digest = path.fingerprint(wide);
+		if (!digest) return {};
+
+		std::unique_lock lock(m_mutex);
+		m_entries[key] = { info.size(), info.mtime(), wide, *digest };
+
+		return digest;
+	}
+
+	/// @brief Fingerprints every path through the cache, keeping input order
+	QList<std::optional<Digest>> cached
+	(
+		const QList<Path>& paths,
+		Wide wide = Wide::Yes,
+		int threadCount = 0
+	)
+	{
+		return _batch
+		(
+			paths,
+			threadCount,
+			[&](const Path& path) { return cached(path, wide); }
+		);
+	}
+
+	qsizetype cacheSize() const
+	{
+		std::shared_lock lock(m_mutex);
+		return static_cast<qsizetype>(m_entries.size());
+	}
+
+	void clearCache()
+	{
+		std::unique_lock lock(m_mutex);
+		m_entries.clear();
+	}
+
+private:
+	struct Key
+	{
+		std::uint64_t device = 0;
+		std::uint64_t inode = 0;
+		Path path{}; // Only when there's no inode
+
+		bool operator==(const Key&) const = default;
+	};
+
+	struct KeyHash
+	{
+		std::size_t operator()(const Key& key) const
+		{
+			auto hash = std::hash<Path>{}(key.path);
+
+			for (auto value : { key.device, key.inode })
+				hash ^= value + 0x9E3779B97F4A7C15ULL + (hash << 6) + (hash >> 2);
+
+			return hash;
+		}
+	};
+
+	struct Entry
+	{
+		std::uint64_t size = 0;
+		std::int64_t mtime = 0;
+		Wide wide = Wide::No;
+		Digest digest{};
+	};
+
+	mutable std::shared_mutex m_mutex{};
+	std::unordered_map<Key, Entry, KeyHash> m_entries{};
+
+	static Key _key(const Path& path, const PathInfo& info)
+	{
+		if (info.inode() != 0)
+			return { info.device(), info.inode(), {} };
+
+		return { 0, 0, path };
+	}
+
+	static bool _isFresh(const Entry& entry, const PathInfo& info, Wide wide)
+	{
+		// A narrow entry can't answer for a wide request
+		return entry.size == info.size()
+			&& entry.mtime == info.mtime()
+			&& (entry.wide == Wide::Yes || wide == Wide::No);
+	}
+
+	template <typename FuncT>
+	static QList<std::optional<Digest>> _batch
+	(
+		const QList<Path>& paths,
+		int threadCount,
+		FuncT func
+	)
+	{
+		// One file per task: sizes vary too much to batch
+		return PathWorkers::fill<QList<std::optional<Digest>>>
+		(
+			static_cast<std::size_t>(paths.size()),
+			[&](std::size_t i) { return func(paths.at(i)); },
+			threadCount,
+			1
+		);
+	}
+
+}; // class PathFingerprint
@@ -0,0 +1,446 @@
+#pragma once
+
+/*
+* cc/PathGlob.hpp  Copyright (C) 2026  fairybow
+*
+* You should have received a copy of the GNU General Public License along with
+* this program. If not, see <https://www.gnu.org/licenses/>.
+*
+* This file uses Qt 6. Qt is a free and open-source widget toolkit for creating
+* graphical user interfaces. For more information, visit <https://www.qt.io/>.
+*
+* Updated: 2026-10-16
+*/
+
+#include <QChar>
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QStringView>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+/// @brief A set of include and exclude globs compiled into one automaton, so
+/// a tree can be walked once and tested against every pattern per entry
+/// @details Patterns are matched against paths relative to the walk's root,
+/// split on '/'. Within a component, '*' matches any run of characters, '?'
+/// one character, and "[a-z]" / "[!a-z]" a class; "{a,b}" expands to each
+/// alternative. A "**" component matches any number of components. A pattern
+/// starting with '!' excludes, and a pattern with no '/' matches the file
+/// name at any depth (so "*.cpp" means "**/*.cpp"). With no include patterns,
+/// everything not excluded is included
+///
+/// Each pattern is a chain of components, and the automaton's state is the
+/// set of chain positions still alive. A walk carries that set down the tree,
+/// stepping it once per entry name; a directory whose set is already excluded
+/// or can no longer reach an include is pruned without being listed
+class PathGlob
+{
+public:
+	using States = std::vector<std::uint32_t>;
+
+	PathGlob
+	(
+		const QStringList& patterns,
+		Qt::CaseSensitivity cs = Qt::CaseInsensitive
+	)
+		: m_cs(cs)
+	{
+		auto has_include = false;
+
+		for (auto& pattern : patterns)
+		{
+			auto exclude = pattern.startsWith(u'!');
+			auto body = exclude ? pattern.mid(1) : pattern;
+			if (body.isEmpty()) continue;
+
+			has_include |= !exclude;
+
+			for (auto& expanded : _expandBraces(body))
+				_compile(expanded, exclude);
+		}
+
+		if (!has_include)
+			_compile(QStringLiteral("**"), false);
+	}
+
+	/// @brief The state at the walk's root (before any name is consumed)
+	States initial() const
+	{
+		States states{};
+
+		for (auto start : m_starts)
+			_add(states, start);
+
+		return states;
+	}
+
+	/// @brief Steps the states over one entry name
+	States step(const States& states, QStringView name) const
+	{
+		States next{};
+
+		for (auto state : states)
+		{
+			auto& segment = m_segments[state];
+
+			switch (segment.kind)
+			{
+			case Kind::Accept:
+				break;
+
+			case Kind::Globstar:
+				_add(next, state);
+				break;
+
+			default:
+				if (_matches(segment, name))
+					_add(next, state + 1);
+				break;
+			}
+		}
+
+		return next;
+	}
+
+	/// @brief Whether a file reaching these states is a result
+	bool accepts(const States& states) const
+	{
+		auto included = false;
+
+		for (auto state : states)
+		{
+			auto& segment = m_segments[state];
+			if (segment.kind != Kind::Accept) continue;
+			if (segment.exclude) return false;
+
+			included = true;
+		}
+
+		return included;
+	}
+
+	/// @brief Whether a directory reaching these states needn't be listed:
+	/// it's excluded outright, or no include pattern can match beneath it
+	bool prunes(const States& states) const
+	{
+		auto alive = false;
+
+		for (auto state : states)
+		{
+			auto& segment = m_segments[state];
+
+			if (segment.kind == Kind::Accept)
+			{
+				if (segment.exclude) return true;
+			}
+			else if (!segment.exclude)
+				alive = true;
+		}
+
+		return !alive;
+	}
+
+	/// @brief Tests a whole relative path ('/'-separated) against the globs
+	bool matches(QStringView relativePath) const
+	{
+		auto states = initial();
+		qsizetype start = 0;
+
+		for (qsizetype i = 0; i <= relativePath.size(); ++i)
+		{
+			if (i < relativePath.size() && relativePath[i] != u'/') continue;
+
+			if (i > start)
+			{
+				states = step(states, relativePath.mid(start, i - start));
+				if (states.empty()) return false;
+			}
+
+			start = i + 1;
+		}
+
+		return accepts(states);
+	}
+
+private:
+	enum class Kind { Literal, Any, Suffix, Wildcard, Globstar, Accept };
+
+	struct Segment
+	{
+		Kind kind = Kind::Accept;
+		QString text{}; // Literal/Wildcard text, or the Suffix after '*'
+		bool exclude = false;
+	};
+
+	Qt::CaseSensitivity m_cs;
+	std::vector<Segment> m_segments{};
+	std::vector<std::uint32_t> m_starts{};
+
+	/// @brief Adds a state plus whatever it reaches without consuming a name
+	/// ("**" may match zero components)
+	void _add(States& states, std::uint32_t state) const
+	{
+		while (true)
+		{
+			if (std::find(states.begin(), states.end(), state) != states.end())
+				return;
+
+			states.push_back(state);
+			if (m_segments[state].kind != Kind::Globstar) return;
+
+			++state;
+		}
+	}
+
+	void _compile(const QString& pattern, bool exclude)
+	{
+		QStringList parts{};
+		qsizetype start = 0;
+
+		for (qsizetype i = 0; i <= pattern.size(); ++i)
+		{
+			if (i < pattern.size() && pattern[i] != u'/') continue;
+
+			auto part = pattern.mid(start, i - start);
+			if (!part.isEmpty() && part != QStringLiteral("."))
+				parts << part;
+
+			start = i + 1;
+		}
+
+		if (parts.isEmpty()) return;
+
+		// Bare names float: "*.cpp" is "**/*.cpp"
+		if (parts.size() == 1 && !pattern.contains(u'/'))
+			parts.prepend(QStringLiteral("**"));
+
+		m_starts.push_back(static_cast<std::uint32_t>(m_segments.size()));
+
+		for (auto& part : parts)
+			m_segments.push_back(_segment(part, exclude));
+
+		m_segments.push_back({ Kind::Accept, {}, exclude });
+	}
+
+	static Segment _segment(const QString& part, bool exclude)
+	{
+		auto is_meta = [](QChar ch)
+			{
+				return ch == u'*' || ch == u'?' || ch == u'[' || ch == u'\\';
+			};
+
+		if (part == QStringLiteral("**"))
+			return { Kind::Globstar, {}, exclude };
+
+		if (part == QStringLiteral("*"))
+			return { Kind::Any, {}, exclude };
+
+		auto rest = part.mid(1);
+
+		if (part.startsWith(u'*')
+			&& std::none_of(rest.begin(), rest.end(), is_meta))
+			return { Kind::Suffix, rest, exclude };
+
+		if (std::none_of(part.begin(), part.end(), is_meta))
+			return { Kind::Literal, part, exclude };
+
+		return { Kind::Wildcard, part, exclude };
+	}
+
+	/// @brief Expands "{a,b}" alternatives (nested too) into plain patterns
+	static QStringList _expandBraces(const QString& pattern)
+	{
+		qsizetype open = -1;
+		auto depth = 0;
+
+		for (qsizetype i = 0; i < pattern.size(); ++i)
+		{
+			auto ch = pattern[i];
+
+			if (ch == u'\\')
+			{
+				++i;
+				continue;
+			}
+
+			if (ch == u'{')
+			{
+				if (depth++ == 0) open = i;
+			}
+			else if (ch == u'}' && depth > 0 && --depth == 0)
+			{
+				auto head = pattern.left(open);
+				auto tail = pattern.mid(i + 1);
+				auto body = pattern.mid(open + 1, i - open - 1);
+				QStringList expanded{};
+
+				for (auto& option : _splitOptions(body))
+					expanded << _expandBraces(head + option + tail);
+
+				return expanded;
+			}
+		}
+
+		return { pattern };
+	}
+
+	static QStringList _splitOptions(const QString& body)
+	{
+		QStringList options{};
+		qsizetype start = 0;
+		auto depth = 0;
+
+		for (qsizetype i = 0; i <= body.size(); ++i)
+		{
+			if (i < body.size())
+			{
+				auto ch = body[i];
+
+				if (ch == u'\\') { ++i; continue; }
+				if (ch == u'{') { ++depth; continue; }
+				if (ch == u'}') { --depth; continue; }
+				if (ch != u',' || depth > 0) continue;
+			}
+
+			options << body.mid(start, i - start);
+			start = i + 1;
+		}
+
+		return options;
+	}
+
+	bool _equal(QChar a, QChar b) const
+	{
+		return m_cs == Qt::CaseSensitive
+			? a == b
+			: a.toCaseFolded() == b.toCaseFolded();
+	}
+
+	bool _matches(const Segment& segment, QStringView name) const
+	{
+		switch (segment.kind)
+		{
+		case Kind::Literal:
+			return name.compare(segment.text, m_cs) == 0;
+
+		case Kind::Any:
+			return true;
+
+		case Kind::Suffix:
+			return name.endsWith(segment.text, m_cs);
+
+		case Kind::Wildcard:
+			return _wildcard(segment.text, name);
+
+		default:
+			return false;
+		}
+	}
+
+	/// @brief Matches one component, backtracking only to the last '*'
+	bool _wildcard(QStringView pattern, QStringView name) const
+	{
+		qsizetype p = 0;
+		qsizetype n = 0;
+		qsizetype star = -1;
+		qsizetype mark = 0;
+
+		while (n < name.size())
+		{
+			if (p < pattern.size())
+			{
+				if (pattern[p] == u'*')
+				{
+					star = ++p;
+					mark = n;
+					continue;
+				}
+
+				if (auto next = _matchOne(pattern, p, name[n]); next > p)
+				{
+					p = next;
+					++n;
+					continue;
+				}
+			}
+
+			if (star < 0) return false;
+
+			p = star;
+			n = ++mark;
+		}
+
+		while (p < pattern.size() && pattern[p] == u'*')
+			++p;
+
+		return p == pattern.size();
+	}
+
+	/// @brief Matches the pattern element at p against ch, returning the
+	/// position after the element, or p if it doesn't match
+	qsizetype _matchOne(QStringView pattern, qsizetype p, QChar ch) const
+	{
+		auto element = pattern[p];
+
+		if (element == u'?') return p + 1;
+
+		if (element == u'\\' && p + 1 < pattern.size())
+			return _equal(pattern[p + 1], ch) ? p + 2 : p;
+
+		if (element == u'[')
+		{
+			auto i = p + 1;
+			auto negate = i < pattern.size()
+				&& (pattern[i] == u'!' || pattern[i] == u'^');
+
+			if (negate) ++i;
+
+			auto first = i;
+			auto matched = false;
+
+			// A ']' straight after the opening is a member, not the end
+			for (; i < pattern.size() && (pattern[i] != u']' || i == first); ++i)
+			{
+				auto low = pattern[i];
+				auto high = low;
+
+				if (i + 2 < pattern.size()
+					&& pattern[i + 1] == u'-' && pattern[i + 2] != u']')
+				{
+					high = pattern[i + 2];
+					i += 2;
+				}
+
+				matched |= _inRange(ch, low, high);
+			}
+
+			// Unterminated: treat '[' as itself
+			if (i >= pattern.size())
+				return _equal(element, ch) ? p + 1 : p;
+
+			return matched != negate ? i + 1 : p;
+		}
+
+		return _equal(element, ch) ? p + 1 : p;
+	}
+
+	bool _inRange(QChar ch, QChar low, QChar high) const
+	{
+		auto in = [&](QChar c)
+			{
+				return low.unicode() <= c.unicode()
+					&& c.unicode() <= high.unicode();
+			};
+
+		if (in(ch)) return true;
+		if (m_cs == Qt::CaseSensitive) return false;
+
+		return in(ch.toCaseFolded())
+			|| in(ch.toLower())
+			|| in(ch.toUpper());
+	}
+
+}; // class PathGlob
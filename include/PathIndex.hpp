@@ -0,0 +1,445 @@
+#pragma once
+
+/*
+* cc/PathIndex.hpp  Copyright (C) 2026  fairybow
+*
+* You should have received a copy of the GNU General Public License along with
+* this program. If not, see <https://www.gnu.org/licenses/>.
+*
+* This file uses Qt 6. Qt is a free and open-source widget toolkit for creating
+* graphical user interfaces. For more information, visit <https://www.qt.io/>.
+*
+* Updated: 2026-10-16
+*/
+
+#include "Path.hpp"
+
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QList>
+#include <QRegularExpression>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+#include <optional>
+
+#ifdef Q_OS_LINUX
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include <cerrno>
+#endif
+
+/// @brief A persistent index of the files under one root, answering the same
+/// queries as Path::findIn from memory
+/// @details The tree is scanned once. On Linux, every folder is then watched
+/// with inotify, and each query first drains pending events (one non-blocking
+/// read), so changes cost work in proportion to what changed. Elsewhere, the
+/// index keeps its seed until rescan() is called. Not thread-safe
+class PathIndex
+{
+public:
+	explicit PathIndex(const Path& root)
+		: m_root(root), m_rootString(root.toQString())
+	{
+		_open();
+		_scan(m_rootString);
+	}
+
+	~PathIndex() { _close(); }
+
+	PathIndex(const PathIndex&) = delete;
+	PathIndex& operator=(const PathIndex&) = delete;
+
+	Path root() const { return m_root; }
+
+	/// @brief False if inotify is unavailable or any indexed folder couldn't
+	/// be watched (e.g., fs.inotify.max_user_watches was hit). A folder that
+	/// vanished before its watch was added doesn't count, and an unwatched
+	/// folder stops counting once it's removed
+	bool isWatching() const
+	{
+		return m_fd >= 0 && m_unwatched == 0;
+	}
+
+	/// @brief Returns what Path::findIn(root(), extension) would, unsorted
+	/// @details A plain extension is a bucket lookup. One with wildcards
+	/// (e.g., "c*" or "?pp") is matched, as findIn's "*.<extension>" filter
+	/// would be, against every indexed file name
+	QList<Path> find(const QString& extension)
+	{
+		sync();
+
+		QList<Path> paths{};
+		_visit(extension, [&](const QString& path) { paths << path; });
+
+		return paths;
+	}
+
+	qsizetype count(const QString& extension)
+	{
+		sync();
+
+		qsizetype count = 0;
+		_visit(extension, [&](const QString&) { ++count; });
+
+		return count;
+	}
+
+	/// @brief Applies any pending change events
+	void sync()
+	{
+#ifdef Q_OS_LINUX
+		if (m_fd < 0) return;
+
+		alignas(inotify_event) char buffer[64 * 1024];
+		auto overflowed = false;
+
+		while (true)
+		{
+			auto length = ::read(m_fd, buffer, sizeof(buffer));
+			if (length <= 0) break; // EAGAIN: drained
+
+			for (auto pos = buffer; pos < buffer + length; )
+			{
+				auto event = reinterpret_cast<const inotify_event*>(pos);
+
+				if (event->mask & IN_Q_OVERFLOW)
+					overflowed = true;
+				else if (!overflowed)
+					_apply(*event);
+
+				pos += sizeof(inotify_event) + event->len;
+			}
+		}
+
+		// Events were lost, so the only safe repair is a fresh scan
+		if (overflowed)
+			rescan();
+#endif
+	}
+
+	/// @brief Drops the index and its watches and scans the root again
+	void rescan()
+	{
+		_close();
+		m_folders.clear();
+		m_watches.clear();
+		m_byExtension.clear();
+		m_unwatched = 0;
+
+		_open();
+		_scan(m_rootString);
+	}
+
+private:
+	struct Folder
+	{
+		int watch = -1;
+		bool unwatched = false; // Counted in m_unwatched
+		QSet<QString> files{};
+		QSet<QString> folders{};
+	};
+
+	Path m_root;
+	QString m_rootString;
+	int m_fd = -1;
+	int m_unwatched = 0;
+	QHash<QString, Folder> m_folders{};
+	QHash<int, QString> m_watches{};
+
+	// Full paths, keyed by the lowercased text after the last dot
+	QHash<QString, QSet<QString>> m_byExtension{};
+
+	void _open()
+	{
+#ifdef Q_OS_LINUX
+		m_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+#endif
+	}
+
+	void _close()
+	{
+#ifdef Q_OS_LINUX
+		if (m_fd >= 0)
+			::close(m_fd);
+#endif
+		m_fd = -1;
+	}
+
+	// QDir::Files doesn't list hidden entries, and QDirIterator won't
+	// descend into hidden folders without QDir::Hidden
+	static bool _isHidden(const QString& name)
+	{
+		return name.startsWith(u'.');
+	}
+
+	static QString _child(const QString& folder, const QString& name)
+	{
+		if (folder.endsWith(u'/'))
+			return folder + name;
+
+		return folder + u'/' + name;
+	}
+
+	static std::optional<QString> _key(const QString& name)
+	{
+		auto dot = name.lastIndexOf(u'.');
+		if (dot <= 0) return std::nullopt;
+
+		return name.mid(dot + 1).toLower();
+	}
+
+	/// @brief Matches like findIn's "*.<extension>" filter, which QDirIterator
+	/// applies case-insensitively
+	template <typename VisitorT>
+	void _visit(const QString& extension, VisitorT visitor) const
+	{
+		if (_isWildcard(extension))
+		{
+			_visitWildcard(extension, visitor);
+			return;
+		}
+
+		auto lower = extension.toLower();
+		auto dot = lower.lastIndexOf(u'.');
+		auto it = m_byExtension.constFind(lower.mid(dot + 1));
+		if (it == m_byExtension.constEnd()) return;
+
+		// Multi-part extensions (e.g., "tar.gz") share the last part's bucket
+		QString suffix{};
+		if (dot >= 0) suffix = u'.' + lower;
+
+		for (auto& path : it.value())
+			if (suffix.isEmpty() || path.endsWith(suffix, Qt::CaseInsensitive))
+				visitor(path);
+	}
+
+	static bool _isWildcard(const QString& extension)
+	{
+		for (auto c : extension)
+			if (c == u'*' || c == u'?' || c == u'[')
+				return true;
+
+		return false;
+	}
+
+	template <typename VisitorT>
+	void _visitWildcard(const QString& extension, VisitorT visitor) const
+	{
+		QRegularExpression filter
+		(
+			QRegularExpression::wildcardToRegularExpression("*." + extension),
+			QRegularExpression::CaseInsensitiveOption
+		);
+
+		for (auto it = m_folders.cbegin(); it != m_folders.cend(); ++it)
+			for (auto& name : it->files)
+				if (filter.match(name).hasMatch())
+					visitor(_child(it.key(), name));
+	}
+
+	void _scan(const QString& top)
+	{
+		QStringList stack{ top };
+
+		while (!stack.isEmpty())
+		{
+			auto folder = stack.takeLast();
+
+			// Watch before listing, so nothing created mid-listing is missed
+			// (anything seen twice is deduplicated by the sets). A folder
+			// that's already gone is left for its parent's delete event
+			if (!_watch(folder)) continue;
+
+			QDirIterator it
+			(
+				folder,
+				QDir::Files | QDir::AllDirs | QDir::NoDotAndDotDot
+			);
+
+			while (it.hasNext())
+			{
+				it.next();
+				auto info = it.fileInfo();
+
+				if (info.isDir())
+				{
+					if (info.isSymLink()) continue;
+
+					m_folders[folder].folders.insert(it.fileName());
+					stack << it.filePath();
+				}
+				else
+					_addFile(folder, it.fileName());
+			}
+		}
+	}
+
+	/// @brief Adds folder's entry, watched if possible. Returns false (adding
+	/// nothing) if the folder no longer exists
+	bool _watch(const QString& folder)
+	{
+#ifdef Q_OS_LINUX
+		if (m_fd < 0)
+		{
+			m_folders[folder];
+			return true;
+		}
+
+		constexpr auto mask = IN_CREATE | IN_DELETE | IN_MOVED_FROM
+			| IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR
+			| IN_DONT_FOLLOW;
+
+		auto watch = inotify_add_watch
+		(
+			m_fd,
+			QFile::encodeName(folder).constData(),
+			mask
+		);
+
+		if (watch < 0)
+		{
+			if (errno == ENOENT || errno == ENOTDIR) return false;
+
+			auto& entry = m_folders[folder];
+
+			if (!entry.unwatched)
+			{
+				entry.unwatched = true;
+				++m_unwatched;
+			}
+
+			return true;
+		}
+
+		m_folders[folder].watch = watch;
+		m_watches[watch] = folder;
+#else
+		m_folders[folder];
+#endif
+
+		return true;
+	}
+
+#ifdef Q_OS_LINUX
+	void _apply(const inotify_event& event)
+	{
+		auto it = m_watches.constFind(event.wd);
+		if (it == m_watches.constEnd()) return;
+
+		auto folder = it.value();
+
+		if (event.mask & IN_IGNORED)
+		{
+			m_watches.remove(event.wd);
+			return;
+		}
+
+		// Subfolders are handled by their parent's events, but if the root
+		// itself goes away, there is nothing left to index
+		if (event.mask & (IN_DELETE_SELF | IN_MOVE_SELF))
+		{
+			if (folder == m_rootString)
+				_removeFolder(folder);
+
+			return;
+		}
+
+		if (event.len == 0) return;
+
+		auto name = QFile::decodeName(event.name);
+		if (_isHidden(name)) return;
+
+		auto path = _child(folder, name);
+
+		if (event.mask & (IN_CREATE | IN_MOVED_TO))
+		{
+			if (event.mask & IN_ISDIR)
+			{
+				m_folders[folder].folders.insert(name);
+				_scan(path);
+			}
+			// Matches QDir::Files: symlinks to files count, symlinks to
+			// folders and broken symlinks don't
+			else if (QFileInfo(path).isFile())
+				_addFile(folder, name);
+		}
+		else if (event.mask & (IN_DELETE | IN_MOVED_FROM))
+		{
+			if (event.mask & IN_ISDIR)
+			{
+				if (auto parent = m_folders.find(folder); parent != m_folders.end())
+					parent->folders.remove(name);
+
+				_removeFolder(path);
+			}
+			else
+				_removeFile(folder, name);
+		}
+	}
+#endif
+
+	void _addFile(const QString& folder, const QString& name)
+	{
+		m_folders[folder].files.insert(name);
+
+		if (auto key = _key(name))
+			m_byExtension[*key].insert(_child(folder, name));
+	}
+
+	void _removeFile(const QString& folder, const QString& name)
+	{
+		if (auto it = m_folders.find(folder); it != m_folders.end())
+			it->files.remove(name);
+
+		_unindex(folder, name);
+	}
+
+	void _unindex(const QString& folder, const QString& name)
+	{
+		auto key = _key(name);
+		if (!key) return;
+
+		auto it = m_byExtension.find(*key);
+		if (it == m_byExtension.end()) return;
+
+		it->remove(_child(folder, name));
+
+		if (it->isEmpty())
+			m_byExtension.erase(it);
+	}
+
+	void _removeFolder(const QString& path)
+	{
+		auto it = m_folders.find(path);
+		if (it == m_folders.end()) return;
+
+		auto folder = std::move(*it);
+		m_folders.erase(it);
+
+		for (auto& name : folder.files)
+			_unindex(path, name);
+
+		for (auto& name : folder.folders)
+			_removeFolder(_child(path, name));
+
+		if (folder.unwatched)
+			--m_unwatched;
+
+#ifdef Q_OS_LINUX
+		// Moved-away folders keep their watch, so drop it here (for deleted
+		// folders the kernel already has, and this is a harmless no-op)
+		if (folder.watch >= 0)
+		{
+			m_watches.remove(folder.watch);
+			inotify_rm_watch(m_fd, folder.watch);
+		}
+#endif
+	}
+
+}; // class PathIndex
@@ -0,0 +1,205 @@
+#pragma once
+
+/*
+* cc/PathInfo.hpp  Copyright (C) 2026  fairybow
+*
+* You should have received a copy of the GNU General Public License along with
+* this program. If not, see <https://www.gnu.org/licenses/>.
+*
+* This file uses Qt 6. Qt is a free and open-source widget toolkit for creating
+* graphical user interfaces. For more information, visit <https://www.qt.io/>.
+*
+* Updated: 2026-10-16
+*/
+
+#include "Path.hpp"
+#include "PathWorkers.hpp"
+
+#include <QDateTime>
+#include <QFileDevice>
+#include <QFileInfo>
+#include <QList>
+
+#include <cstdint>
+#include <filesystem>
+
+#ifdef Q_OS_LINUX
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/sysmacros.h>
+
+#include <cerrno>
+#endif
+
+/// @brief A snapshot of a path's metadata, taken with one stat call, so code
+/// checking several properties doesn't stat the file again for each
+/// @details Symlinks are followed, as with Path::isFile() and friends. On
+/// Linux this is a single statx (stat on kernels without it); elsewhere it is
+/// one QFileInfo
+class PathInfo
+{
+public:
+	enum class Type { Missing = 0, File, Folder, Other };
+
+	PathInfo() = default;
+
+	static PathInfo of(const Path& path)
+	{
+		PathInfo info{};
+
+#ifdef Q_OS_LINUX
+		auto native = path.toStd().c_str();
+		struct statx buffer{};
+
+		constexpr auto mask = STATX_TYPE | STATX_MODE | STATX_SIZE
+			| STATX_MTIME | STATX_INO;
+
+		if (::statx(AT_FDCWD, native, 0, mask, &buffer) == 0)
+		{
+			info._fill
+			(
+				buffer.stx_mode,
+				buffer.stx_size,
+				std::int64_t(buffer.stx_mtime.tv_sec) * 1'000'000'000
+					+ buffer.stx_mtime.tv_nsec,
+				makedev(buffer.stx_dev_major, buffer.stx_dev_minor),
+				buffer.stx_ino
+			);
+		}
+		else if (errno == ENOSYS)
+		{
+			struct stat fallback{};
+
+			if (::stat(native, &fallback) == 0)
+				info._fill
+				(
+					fallback.st_mode,
+					fallback.st_size,
+					std::int64_t(fallback.st_mtim.tv_sec) * 1'000'000'000
+						+ fallback.st_mtim.tv_nsec,
+					fallback.st_dev,
+					fallback.st_ino
+				);
+		}
+#else
+		QFileInfo file_info(path.toQString());
+		if (!file_info.exists()) return info;
+
+		info.m_type = file_info.isFile()
+			? Type::File
+			: file_info.isDir() ? Type::Folder : Type::Other;
+
+		info.m_size = static_cast<std::uint64_t>(file_info.size());
+		info.m_mtime = file_info.lastModified().toMSecsSinceEpoch()
+			* 1'000'000;
+		info.m_mode = _typeToMode(info.m_type, path)
+			| _qtPermissionsToMode(file_info.permissions());
+#endif
+
+		return info;
+	}
+
+	/// @brief Snapshots every path across a thread pool, keeping input order.
+	/// Short lists are done on the calling thread
+	static QList<PathInfo> of
+	(
+		const QList<Path>& paths,
+		int threadCount = 0
+	)
+	{
+		return PathWorkers::fill<QList<PathInfo>>
+		(
+			static_cast<std::size_t>(paths.size()),
+			[&](std::size_t i) { return of(paths.at(i)); },
+			threadCount
+		);
+	}
+
+	Type type() const { return m_type; }
+	bool exists() const { return m_type != Type::Missing; }
+	bool isFile() const { return m_type == Type::File; }
+	bool isFolder() const { return m_type == Type::Folder; }
+
+	std::uint64_t size() const { return m_size; }
+
+	/// @brief Nanoseconds since the Unix epoch
+	std::int64_t mtime() const { return m_mtime; }
+
+	/// @brief POSIX st_mode bits (type and permissions). Off Linux, the
+	/// type bits are 0 for types std::filesystem can't name
+	std::uint32_t mode() const { return m_mode; }
+
+	/// @brief Device and inode (Linux only; zero elsewhere)
+	std::uint64_t device() const { return m_device; }
+	std::uint64_t inode() const { return m_inode; }
+
+private:
+	Type m_type = Type::Missing;
+	std::uint64_t m_size = 0;
+	std::int64_t m_mtime = 0;
+	std::uint32_t m_mode = 0;
+	std::uint64_t m_device = 0;
+	std::uint64_t m_inode = 0;
+
+#ifdef Q_OS_LINUX
+	void _fill
+	(
+		std::uint32_t mode,
+		std::uint64_t size,
+		std::int64_t mtime,
+		std::uint64_t device,
+		std::uint64_t inode
+	)
+	{
+		m_type = S_ISREG(mode)
+			? Type::File
+			: S_ISDIR(mode) ? Type::Folder : Type::Other;
+
+		m_size = size;
+		m_mtime = mtime;
+		m_mode = mode;
+		m_device = device;
+		m_inode = inode;
+	}
+#else
+	/// @brief The st_mode type bits. QFileInfo only tells files and folders
+	/// apart, so other types (rare) cost one more stat
+	static std::uint32_t _typeToMode(Type type, const Path& path)
+	{
+		if (type == Type::File) return 0100000;
+		if (type == Type::Folder) return 0040000;
+
+		std::error_code error{};
+
+		switch (std::filesystem::status(path.toStd(), error).type())
+		{
+		case std::filesystem::file_type::fifo: return 0010000;
+		case std::filesystem::file_type::character: return 0020000;
+		case std::filesystem::file_type::block: return 0060000;
+		case std::filesystem::file_type::socket: return 0140000;
+		default: return 0;
+		}
+	}
+
+	static std::uint32_t _qtPermissionsToMode
+	(
+		QFileDevice::Permissions permissions
+	)
+	{
+		std::uint32_t mode = 0;
+
+		if (permissions & QFileDevice::ReadOwner) mode |= 0400;
+		if (permissions & QFileDevice::WriteOwner) mode |= 0200;
+		if (permissions & QFileDevice::ExeOwner) mode |= 0100;
+		if (permissions & QFileDevice::ReadGroup) mode |= 0040;
+		if (permissions & QFileDevice::WriteGroup) mode |= 0020;
+		if (permissions & QFileDevice::ExeGroup) mode |= 0010;
+		if (permissions & QFileDevice::ReadOther) mode |= 0004;
+		if (permissions & QFileDevice::WriteOther) mode |= 0002;
+		if (permissions & QFileDevice::ExeOther) mode |= 0001;
+
+		return mode;
+	}
+#endif
+
+}; // class PathInfo
@@ -0,0 +1,599 @@
+#pragma once
+
+/*
+* cc/PathList.hpp  Copyright (C) 2026  fairybow
+*
+* You should have received a copy of the GNU General Public License along with
+* this program. If not, see <https://www.gnu.org/licenses/>.
+*
+* This file uses Qt 6. Qt is a free and open-source widget toolkit for creating
+* graphical user interfaces. For more information, visit <https://www.qt.io/>.
+*
+* Updated: 2026-10-16
+*/
+
+#include "Path.hpp"
+#include "PathWorkers.hpp"
+
+#include <QDir>
+#include <QDirIterator>
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QtGlobal>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+/// @brief A list of paths stored column-wise: every path's characters in one
+/// buffer, plus an offset table, instead of one heap object per Path
+/// @details compress() front-codes the list (each entry stores only what
+/// differs from the one before it, restarting every 16 entries), which
+/// shrinks deep trees considerably. A compressed list still answers size()
+/// and at(), and iterating it decodes entries in turn, but anything that edits
+/// it decompresses it first (and view() requires an uncompressed list)
+class PathList
+{
+public:
+	using char_type = std::filesystem::path::value_type;
+	using string_type = std::filesystem::path::string_type;
+	using view_type = std::basic_string_view<char_type>;
+
+	enum class Order { Bytewise = 0, Natural };
+
+	class Iterator
+	{
+	public:
+		using iterator_category = std::input_iterator_tag;
+		using value_type = view_type;
+		using difference_type = std::ptrdiff_t;
+		using pointer = void;
+		using reference = view_type;
+
+		Iterator() = default;
+		Iterator(const PathList* list, qsizetype index)
+			: m_list(list), m_index(index)
+		{
+			_seek();
+		}
+
+		/// @brief For a compressed list, the view is into this iterator and
+		/// lasts until it's incremented
+		reference operator*() const
+		{
+			return m_list->m_compressed
+				? view_type(m_current)
+				: m_list->view(m_index);
+		}
+
+		Iterator& operator++()
+		{
+			++m_index;
+			_decode();
+
+			return *this;
+		}
+
+		Iterator operator++(int)
+		{
+			auto copy = *this;
+			++*this;
+
+			return copy;
+		}
+
+		bool operator==(const Iterator& other) const
+		{
+			return m_list == other.m_list && m_index == other.m_index;
+		}
+
+	private:
+		const PathList* m_list = nullptr;
+		qsizetype m_index = 0;
+
+		// Compressed lists only: the entry at m_index, and where the next
+		// one starts in the packed buffer
+		string_type m_current{};
+		std::size_t m_position = 0;
+
+		bool _isPacked() const
+		{
+			return m_list && m_list->m_compressed
+				&& m_index < m_list->m_packedCount;
+		}
+
+		// Decodes forward from the start of m_index's block, as at() does
+		void _seek()
+		{
+			if (!_isPacked()) return;
+
+			auto i = static_cast<std::size_t>(m_index);
+			auto block = i / RESTART_INTERVAL;
+			m_position = m_list->m_blocks[block];
+
+			for (auto j = block * RESTART_INTERVAL; j <= i; ++j)
+				m_list->_decode(m_position, m_current);
+		}
+
+		void _decode()
+		{
+			if (_isPacked())
+				m_list->_decode(m_position, m_current);
+		}
+
+	}; // class PathList::Iterator
+
+	PathList() = default;
+
+	explicit PathList(const QList<Path>& paths)
+	{
+		reserve(paths.size());
+
+		for (auto& path : paths)
+			append(path);
+	}
+
+	/// @brief Like Path::findIn, but each result is appended straight into
+	/// the buffer rather than becoming its own Path
+	static PathList findIn
+	(
+		const Path& directory,
+		const QString& extension,
+		Path::Recursive recursive = Path::Recursive::Yes
+	)
+	{
+		PathList list{};
+
+		auto it = Path::_extensionIterator(directory, extension, recursive);
+
+		while (it.hasNext())
+			list._append(it.next());
+
+		return list;
+	}
+
+	qsizetype size() const
+	{
+		return m_compressed
+			? m_packedCount
+			: static_cast<qsizetype>(m_entries.size());
+	}
+
+	bool isEmpty() const { return size() == 0; }
+	bool isCompressed() const { return m_compressed; }
+
+	/// @brief Approximate heap bytes held by the list
+	std::size_t memoryUsage() const
+	{
+		return m_chars.capacity() * sizeof(char_type)
+			+ m_entries.capacity() * sizeof(Entry)
+			+ m_packed.capacity()
+			+ m_blocks.capacity() * sizeof(std::size_t);
+	}
+
+	void clear()
+	{
+		*this = PathList{};
+	}
+
+	void reserve(qsizetype count, std::size_t chars = 0)
+	{
+		decompress();
+		m_entries.reserve(static_cast<std::size_t>(count));
+		if (chars) m_chars.reserve(chars);
+	}
+
+	void append(const Path& path) { append(view_type(path.native())); }
+
+	void append(view_type path)
+	{
+		decompress();
+
+		m_entries.push_back({ m_chars.size(), path.size() });
+		m_chars.append(path);
+	}
+
+	PathList& operator<<(const Path& path)
+	{
+		append(path);
+		return *this;
+	}
+
+	/// @brief A view into the buffer (uncompressed lists only), valid until
+	/// the list is next modified
+	view_type view(qsizetype index) const
+	{
+		Q_ASSERT(!m_compressed);
+		return _view(m_entries[static_cast<std::size_t>(index)]);
+	}
+
+	Path at(qsizetype index) const
+	{
+		if (!m_compressed)
+			return std::filesystem::path(view(index));
+
+		string_type current{};
+		auto i = static_cast<std::size_t>(index);
+		auto block = i / RESTART_INTERVAL;
+		auto position = m_blocks[block];
+
+		for (auto j = block * RESTART_INTERVAL; j <= i; ++j)
+			_decode(position, current);
+
+		return std::filesystem::path(std::move(current));
+	}
+
+	Iterator begin() const { return Iterator(this, 0); }
+	Iterator end() const { return Iterator(this, size()); }
+
+	QList<Path> toList() const
+	{
+		QList<Path> paths{};
+		paths.reserve(size());
+
+		if (!m_compressed)
+		{
+			for (auto& entry : m_entries)
+				paths << Path(std::filesystem::path(_view(entry)));
+
+			return paths;
+		}
+
+		string_type current{};
+		std::size_t position = 0;
+
+		for (qsizetype i = 0; i < m_packedCount; ++i)
+		{
+			_decode(position, current);
+			paths << Path(std::filesystem::path(current));
+		}
+
+		return paths;
+	}
+
+	/// @brief Sorts by characters (Bytewise) or with digit runs compared by
+	/// value (Natural: "file2" before "file10"). Chunks are sorted across the
+	/// worker pool and then merged pairwise
+	void sort(Order order = Order::Bytewise, int threadCount = 0)
+	{
+		decompress();
+
+		if (order == Order::Natural)
+			_sort
+			(
+				[this](const Entry& a, const Entry& b)
+				{
+					return _naturalLess(_view(a), _view(b));
+				},
+				threadCount
+			);
+		else
+			_sort
+			(
+				[this](const Entry& a, const Entry& b)
+				{
+					return _view(a) < _view(b);
+				},
+				threadCount
+			);
+	}
+
+	/// @brief Removes adjacent duplicates (so, all duplicates once sorted)
+	/// and repacks the buffer
+	void dedup()
+	{
+		decompress();
+
+		auto end = std::unique
+		(
+			m_entries.begin(),
+			m_entries.end(),
+			[this](const Entry& a, const Entry& b)
+			{
+				return _view(a) == _view(b);
+			}
+		);
+
+		m_entries.erase(end, m_entries.end());
+		squeeze();
+	}
+
+	/// @brief Rewrites the buffer in list order, dropping space left behind
+	/// by dedup() and spare capacity
+	void squeeze()
+	{
+		decompress();
+
+		string_type chars{};
+		std::size_t total = 0;
+
+		for (auto& entry : m_entries)
+			total += entry.length;
+
+		chars.reserve(total);
+
+		for (auto& entry : m_entries)
+		{
+			auto offset = chars.size();
+			chars.append(_view(entry));
+			entry.offset = offset;
+		}
+
+		m_chars = std::move(chars);
+		m_entries.shrink_to_fit();
+	}
+
+	void compress()
+	{
+		if (m_compressed) return;
+
+		std::vector<unsigned char> packed{};
+		std::vector<std::size_t> blocks{};
+		view_type previous{};
+
+		blocks.reserve(m_entries.size() / RESTART_INTERVAL + 1);
+
+		for (std::size_t i = 0; i < m_entries.size(); ++i)
+		{
+			auto current = _view(m_entries[i]);
+			std::size_t shared = 0;
+
+			if (i % RESTART_INTERVAL == 0)
+				blocks.push_back(packed.size());
+			else
+			{
+				auto limit = std::min(previous.size(), current.size());
+				while (shared < limit && previous[shared] == current[shared])
+					++shared;
+			}
+
+			auto suffix = current.substr(shared);
+
+			_putVarint(packed, shared);
+			_putVarint(packed, suffix.size());
+
+			auto bytes = reinterpret_cast<const unsigned char*>(suffix.data());
+			auto byte_count = suffix.size() * sizeof(char_type);
+			packed.insert(packed.end(), bytes, bytes + byte_count);
+
+			previous = current;
+		}
+
+		packed.shrink_to_fit();
+
+		m_packedCount = static_cast<qsizetype>(m_entries.size());
+		m_packed = std::move(packed);
+		m_blocks = std::move(blocks);
+		m_chars = string_type{};
+		m_entries = std::vector<Entry>{};
+		m_compressed = true;
+	}
+
+	void decompress()
+	{
+		if (!m_compressed) return;
+
+		string_type current{};
+		std::size_t position = 0;
+
+		m_entries.reserve(static_cast<std::size_t>(m_packedCount));
+
+		for (qsizetype i = 0; i < m_packedCount; ++i)
+		{
+			_decode(position, current);
+			m_entries.push_back({ m_chars.size(), current.size() });
+			m_chars.append(current);
+		}
+
+		m_packed = std::vector<unsigned char>{};
+		m_blocks = std::vector<std::size_t>{};
+		m_packedCount = 0;
+		m_compressed = false;
+	}
+
+private:
+	constexpr static std::size_t RESTART_INTERVAL = 16;
+	constexpr static std::size_t PARALLEL_SORT_THRESHOLD = 8192;
+
+	struct Entry
+	{
+		std::size_t offset = 0;
+		std::size_t length = 0;
+	};
+
+	string_type m_chars{};
+	std::vector<Entry> m_entries{};
+
+	// Front-coded form: (shared, suffix length, suffix) per entry, with
+	// m_blocks holding the byte offset of every RESTART_INTERVAL-th entry
+	std::vector<unsigned char> m_packed{};
+	std::vector<std::size_t> m_blocks{};
+	qsizetype m_packedCount = 0;
+	bool m_compressed = false;
+
+	view_type _view(const Entry& entry) const
+	{
+		return view_type(m_chars).substr(entry.offset, entry.length);
+	}
+
+	void _append(const QString& path)
+	{
+		if constexpr (std::is_same_v<char_type, char>)
+		{
+			auto utf8 = path.toUtf8();
+			append(view_type(utf8.constData(), utf8.size()));
+		}
+		else
+			append
+			(
+				view_type
+				(
+					reinterpret_cast<const char_type*>(path.utf16()),
+					path.size()
+				)
+			);
+	}
+
+	static void _putVarint(std::vector<unsigned char>& out, std::size_t value)
+	{
+		while (value >= 0x80)
+		{
+			out.push_back(static_cast<unsigned char>(value | 0x80));
+			value >>= 7;
+		}
+
+		out.push_back(static_cast<unsigned char>(value));
+	}
+
+	std::size_t _getVarint(std::size_t& position) const
+	{
+		std::size_t value = 0;
+		auto shift = 0;
+
+		while (true)
+		{
+			auto byte = m_packed[position++];
+			value |= std::size_t(byte & 0x7F) << shift;
+			if (!(byte & 0x80)) return value;
+
+			shift += 7;
+		}
+	}
+
+	/// @brief Turns current (the previous entry) into the entry at position
+	void _decode(std::size_t& position, string_type& current) const
+	{
+		auto shared = _getVarint(position);
+		auto length = _getVarint(position);
+
+		current.resize(shared + length);
+		std::memcpy
+		(
+			current.data() + shared,
+			m_packed.data() + position,
+			length * sizeof(char_type)
+		);
+
+		position += length * sizeof(char_type);
+	}
+
+	static bool _isDigit(char_type ch)
+	{
+		return ch >= char_type('0') && ch <= char_type('9');
+	}
+
+	static bool _naturalLess(view_type a, view_type b)
+	{
+		using Traits = std::char_traits<char_type>;
+		std::size_t i = 0;
+		std::size_t j = 0;
+
+		while (i < a.size() && j < b.size())
+		{
+			if (!_isDigit(a[i]) || !_isDigit(b[j]))
+			{
+				if (a[i] != b[j]) return Traits::lt(a[i], b[j]);
+
+				++i;
+				++j;
+				continue;
+			}
+
+			// Compare digit runs by value: ignore leading zeros, then the
+			// longer run is bigger, then compare digit by digit
+			auto a_start = i;
+			auto b_start = j;
+
+			while (i < a.size() && a[i] == char_type('0')) ++i;
+			while (j < b.size() && b[j] == char_type('0')) ++j;
+
+			auto a_digits = i;
+			auto b_digits = j;
+
+			while (i < a.size() && _isDigit(a[i])) ++i;
+			while (j < b.size() && _isDigit(b[j])) ++j;
+
+			auto a_run = a.substr(a_digits, i - a_digits);
+			auto b_run = b.substr(b_digits, j - b_digits);
+
+			if (a_run.size() != b_run.size())
+				return a_run.size() < b_run.size();
+
+			if (auto result = a_run.compare(b_run))
+				return result < 0;
+
+			// Same value: fewer leading zeros first ("1" before "01")
+			auto a_zeros = a_digits - a_start;
+			auto b_zeros = b_digits - b_start;
+			if (a_zeros != b_zeros) return a_zeros < b_zeros;
+		}
+
+		return i == a.size() && j < b.size();
+	}
+
+	template <typename LessT>
+	void _sort(LessT less, int threadCount)
+	{
+		auto size = m_entries.size();
+		auto chunks = static_cast<std::size_t>(PathWorkers::count(threadCount));
+
+		if (size < PARALLEL_SORT_THRESHOLD || chunks < 2)
+		{
+			std::sort(m_entries.begin(), m_entries.end(), less);
+			return;
+		}
+
+		std::vector<std::size_t> bounds(chunks + 1);
+
+		for (std::size_t i = 0; i <= chunks; ++i)
+			bounds[i] = size * i / chunks;
+
+		auto begin = m_entries.begin();
+
+		PathWorkers::forEach
+		(
+			chunks,
+			[&](int, std::size_t chunk)
+			{
+				std::sort(begin + bounds[chunk], begin + bounds[chunk + 1], less);
+			},
+			threadCount,
+			1
+		);
+
+		for (std::size_t width = 1; width < chunks; width *= 2)
+		{
+			auto pairs = (chunks + 2 * width - 1) / (2 * width);
+
+			PathWorkers::forEach
+			(
+				pairs,
+				[&](int, std::size_t pair)
+				{
+					auto first = pair * 2 * width;
+					auto middle = std::min(first + width, chunks);
+					auto last = std::min(first + 2 * width, chunks);
+					if (middle == last) return;
+
+					std::inplace_merge
+					(
+						begin + bounds[first],
+						begin + bounds[middle],
+						begin + bounds[last],
+						less
+					);
+				},
+				threadCount,
+				1
+			);
+		}
+	}
+
+}; // class PathList
@@ -0,0 +1,151 @@
+#pragma once
+
+/*
+* cc/PathLiteral.hpp  Copyright (C) 2026  fairybow
+*
+* You should have received a copy of the GNU General Public License along with
+* this program. If not, see <https://www.gnu.org/licenses/>.
+*
+* This file uses Qt 6. Qt is a free and open-source widget toolkit for creating
+* graphical user interfaces. For more information, visit <https://www.qt.io/>.
+*
+* Updated: 2026-10-16
+*/
+
+#include "Path.hpp"
+
+#include <cstddef>
+#include <filesystem>
+#include <string_view>
+
+/// @brief A fixed path built at compile time: normalized on construction and
+/// joined with operator/, so "config"_path / "cache" / "index.bin" costs
+/// nothing at runtime
+/// @details Normalizing collapses separator runs, drops "." components, and
+/// drops a trailing separator ('..' is kept, as resolving it lexically can be
+/// wrong across symlinks). A path that is only "." stays ".", as Path(".")
+/// does, and joining onto it gives just the right side. Converting to Path
+/// allocates once; view() and c_str() don't allocate at all. Members are
+/// public only because a literal operator template needs a structural type
+template <std::size_t N>
+struct PathLiteral
+{
+	char chars[N]{};
+	std::size_t size = 0;
+
+	constexpr PathLiteral() = default;
+
+	constexpr PathLiteral(const char (&string)[N])
+	{
+		_append(string, N - 1);
+	}
+
+	constexpr std::string_view view() const { return { chars, size }; }
+	constexpr const char* c_str() const { return chars; }
+	constexpr bool isEmpty() const { return size == 0; }
+
+	/// @brief Joins like Path's operator/: an absolute right side replaces
+	/// the left
+	template <std::size_t M>
+	constexpr PathLiteral<N + M> operator/(const PathLiteral<M>& other) const
+	{
+		PathLiteral<N + M> joined{};
+
+		if (!other.isAbsolute())
+			joined._append(chars, size);
+
+		joined._append(other.chars, other.size);
+
+		return joined;
+	}
+
+	template <std::size_t M>
+	constexpr PathLiteral<N + M> operator/(const char (&other)[M]) const
+	{
+		return *this / PathLiteral<M>(other);
+	}
+
+	constexpr bool isAbsolute() const { return size > 0 && chars[0] == '/'; }
+
+	operator Path() const
+	{
+		return Path(std::filesystem::path(view()));
+	}
+
+	template <std::size_t M>
+	constexpr bool operator==(const PathLiteral<M>& other) const
+	{
+		return view() == other.view();
+	}
+
+	/// @brief Appends string (size chars), normalizing as it goes. Assumes
+	/// what's already here is normalized
+	constexpr void _append(const char* string, std::size_t length)
+	{
+		std::size_t i = 0;
+
+		// A leading separator marks an absolute path
+		if (size == 0 && length > 0 && string[0] == '/')
+		{
+			chars[size++] = '/';
+			i = 1;
+		}
+
+		auto dotted = false;
+
+		while (i < length)
+		{
+			while (i < length && string[i] == '/')
+				++i;
+
+			auto start = i;
+
+			while (i < length && string[i] != '/')
+				++i;
+
+			auto count = i - start;
+			if (count == 0) continue;
+
+			if (count == 1 && string[start] == '.')
+			{
+				dotted = true;
+				continue;
+			}
+
+			// A lone "." gives way to the first real component
+			if (size == 1 && chars[0] == '.')
+				size = 0;
+
+			if (size > 0 && chars[size - 1] != '/')
+				chars[size++] = '/';
+
+			for (auto j = start; j < i; ++j)
+				chars[size++] = string[j];
+		}
+
+		if (size == 0 && dotted)
+			chars[size++] = '.';
+
+		chars[size] = '\0';
+	}
+
+}; // struct PathLiteral
+
+// Normalization, checked at compile time
+static_assert(PathLiteral(".").view() == ".");
+static_assert(PathLiteral("./").view() == ".");
+static_assert(PathLiteral("./a/./b/").view() == "a/b");
+static_assert((PathLiteral(".") / "a").view() == "a");
+static_assert((PathLiteral("a") / ".").view() == "a");
+static_assert(PathLiteral("/.").view() == "/");
+
+namespace PathLiterals
+{
+	/// @brief "config/cache"_path: a PathLiteral, normalized at compile time
+	template <PathLiteral Literal>
+	consteval auto operator""_path()
+	{
+		return Literal;
+	}
+
+} // namespace PathLiterals
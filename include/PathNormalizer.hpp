@@ -0,0 +1,267 @@
+#pragma once
+
+/*
+* cc/PathNormalizer.hpp  Copyright (C) 2026  fairybow
+*
+* You should have received a copy of the GNU General Public License along with
+* this program. If not, see <https://www.gnu.org/licenses/>.
+*
+* Updated: 2026-10-16
+*/
+
+#include <cstddef>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define CC_PATH_NORMALIZER_X86
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(CC_PATH_NORMALIZER_X86) && (defined(__GNUC__) || defined(__clang__))
+#define CC_PATH_NORMALIZER_AVX2 __attribute__((target("avx2")))
+#else
+#define CC_PATH_NORMALIZER_AVX2
+#endif
+
+/// @brief Collapses runs of '/' and '\' into single separators, as
+/// Path::toString(Normalize::Yes) does
+/// @details Blocks with no separator runs (the common case) are swapped and
+/// stored whole with SSE2 or AVX2, chosen once at runtime; blocks with runs,
+/// the tail, and non-x86 targets use the scalar loop
+namespace PathNormalizer
+{
+	namespace Detail
+	{
+		inline bool isSeparator(char ch) { return ch == '/' || ch == '\\'; }
+
+		inline std::size_t scalar
+		(
+			const char* in,
+			std::size_t begin,
+			std::size_t end,
+			char* out,
+			std::size_t written,
+			bool& lastWasSeparator,
+			char separator
+		)
+		{
+			for (auto i = begin; i < end; ++i)
+			{
+				if (isSeparator(in[i]))
+				{
+					if (!lastWasSeparator)
+						out[written++] = separator;
+
+					lastWasSeparator = true;
+				}
+				else
+				{
+					out[written++] = in[i];
+					lastWasSeparator = false;
+				}
+			}
+
+			return written;
+		}
+
+		inline std::size_t normalizeScalar
+		(
+			const char* in,
+			std::size_t size,
+			char* out,
+			char separator
+		)
+		{
+			auto last_was_separator = false;
+			return scalar(in, 0, size, out, 0, last_was_separator, separator);
+		}
+
+#ifdef CC_PATH_NORMALIZER_X86
+
+		inline std::size_t normalizeSse2
+		(
+			const char* in,
+			std::size_t size,
+			char* out,
+			char separator
+		)
+		{
+			const auto slash = _mm_set1_epi8('/');
+			const auto backslash = _mm_set1_epi8('\\');
+			const auto replacement = _mm_set1_epi8(separator);
+
+			std::size_t i = 0;
+			std::size_t written = 0;
+			auto last_was_separator = false;
+
+			for (; i + 16 <= size; i += 16)
+			{
+				auto block = _mm_loadu_si128
+				(
+					reinterpret_cast<const __m128i*>(in + i)
+				);
+
+				auto separators = _mm_or_si128
+				(
+					_mm_cmpeq_epi8(block, slash),
+					_mm_cmpeq_epi8(block, backslash)
+				);
+
+				auto mask = static_cast<unsigned>(_mm_movemask_epi8(separators));
+				auto runs = mask & ((mask << 1) | unsigned(last_was_separator));
+
+				if (runs == 0)
+				{
+					// Output trails input, so a full store stays in bounds
+					auto swapped = _mm_or_si128
+					(
+						_mm_and_si128(separators, replacement),
+						_mm_andnot_si128(separators, block)
+					);
+
+					_mm_storeu_si128
+					(
+						reinterpret_cast<__m128i*>(out + written),
+						swapped
+					);
+
+					written += 16;
+					last_was_separator = (mask & 0x8000u) != 0;
+				}
+				else
+					written = scalar
+					(
+						in, i, i + 16, out, written,
+						last_was_separator, separator
+					);
+			}
+
+			return scalar
+			(
+				in, i, size, out, written,
+				last_was_separator, separator
+			);
+		}
+
+		CC_PATH_NORMALIZER_AVX2 inline std::size_t normalizeAvx2
+		(
+			const char* in,
+			std::size_t size,
+			char* out,
+			char separator
+		)
+		{
+			const auto slash = _mm256_set1_epi8('/');
+			const auto backslash = _mm256_set1_epi8('\\');
+			const auto replacement = _mm256_set1_epi8(separator);
+
+			std::size_t i = 0;
+			std::size_t written = 0;
+			auto last_was_separator = false;
+
+			for (; i + 32 <= size; i += 32)
+			{
+				auto block = _mm256_loadu_si256
+				(
+					reinterpret_cast<const __m256i*>(in + i)
+				);
+
+				auto separators = _mm256_or_si256
+				(
+					_mm256_cmpeq_epi8(block, slash),
+					_mm256_cmpeq_epi8(block, backslash)
+				);
+
+				auto mask = static_cast<unsigned>
+				(
+					_mm256_movemask_epi8(separators)
+				);
+
+				auto runs = mask & ((mask << 1) | unsigned(last_was_separator));
+
+				if (runs == 0)
+				{
+					auto swapped = _mm256_blendv_epi8
+					(
+						block,
+						replacement,
+						separators
+					);
+
+					_mm256_storeu_si256
+					(
+						reinterpret_cast<__m256i*>(out + written),
+						swapped
+					);
+
+					written += 32;
+					last_was_separator = (mask & 0x80000000u) != 0;
+				}
+				else
+					written = scalar
+					(
+						in, i, i + 32, out, written,
+						last_was_separator, separator
+					);
+			}
+
+			return scalar
+			(
+				in, i, size, out, written,
+				last_was_separator, separator
+			);
+		}
+
+		inline bool hasAvx2()
+		{
+#if defined(_MSC_VER) && !defined(__clang__)
+			int info[4]{};
+			__cpuid(info, 0);
+			if (info[0] < 7) return false;
+
+			// The OS must also save YMM state (OSXSAVE, then XCR0 bits 1-2)
+			__cpuid(info, 1);
+			if (!(info[2] & (1 << 27))) return false;
+			if ((_xgetbv(0) & 0x6) != 0x6) return false;
+
+			__cpuidex(info, 7, 0);
+			return (info[1] & (1 << 5)) != 0;
+#else
+			return __builtin_cpu_supports("avx2");
+#endif
+		}
+
+#endif // CC_PATH_NORMALIZER_X86
+
+		using Function = std::size_t(*)(const char*, std::size_t, char*, char);
+
+		inline Function select()
+		{
+#ifdef CC_PATH_NORMALIZER_X86
+			if (hasAvx2()) return normalizeAvx2;
+			return normalizeSse2;
+#else
+			return normalizeScalar;
+#endif
+		}
+
+	} // namespace PathNormalizer::Detail
+
+	/// @brief Writes the normalized form of in to out, which must have room
+	/// for size chars (output is never longer), and returns its length. Output
+	/// never gets ahead of input, so in and out may be the same buffer
+	inline std::size_t normalize
+	(
+		const char* in,
+		std::size_t size,
+		char* out,
+		char separator
+	)
+	{
+		static const auto function = Detail::select();
+		return function(in, size, out, separator);
+	}
+
+} // namespace PathNormalizer
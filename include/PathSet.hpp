@@ -0,0 +1,488 @@
+#pragma once
+
+/*
+* cc/PathSet.hpp  Copyright (C) 2026  fairybow
+*
+* You should have received a copy of the GNU General Public License along with
+* this program. If not, see <https://www.gnu.org/licenses/>.
+*
+* This file uses Qt 6. Qt is a free and open-source widget toolkit for creating
+* graphical user interfaces. For more information, visit <https://www.qt.io/>.
+*
+* Updated: 2026-10-16
+*/
+
+#include "Path.hpp"
+
+#include <QString>
+#include <QStringView>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <initializer_list>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/// @brief Hashing and equality shared by PathSet and PathMap. Keys are read
+/// as Unicode code points, so a Path, a QString, and a UTF-8 string with the
+/// same text hash and compare alike without converting (or allocating)
+/// @details Keys match by exact text, not by Path's component-wise equality
+/// (so "a//b" and "a/b" are different keys)
+namespace PathKeys
+{
+	class Utf8Cursor
+	{
+	public:
+		explicit Utf8Cursor(std::string_view text)
+			: m_at(reinterpret_cast<const unsigned char*>(text.data()))
+			, m_end(m_at + text.size())
+		{
+		}
+
+		bool next(char32_t& codePoint)
+		{
+			if (m_at == m_end) return false;
+
+			auto lead = *m_at++;
+
+			if (lead < 0x80)
+			{
+				codePoint = lead;
+				return true;
+			}
+
+			auto extra = lead >= 0xF0 ? 3
+				: lead >= 0xE0 ? 2
+				: lead >= 0xC0 ? 1
+				: 0;
+
+			// Stray bytes map into the low surrogate range, like Python's
+			// surrogateescape, so malformed names still hash consistently
+			if (extra == 0 || m_end - m_at < extra)
+			{
+				codePoint = 0xDC00 + lead;
+				return true;
+			}
+
+			char32_t value = lead & (0x3F >> extra);
+
+			for (auto i = 0; i < extra; ++i)
+			{
+				if ((m_at[i] & 0xC0) != 0x80)
+				{
+					codePoint = 0xDC00 + lead;
+					return true;
+				}
+
+				value = (value << 6) | (m_at[i] & 0x3F);
+			}
+
+			m_at += extra;
+			codePoint = value;
+
+			return true;
+		}
+
+	private:
+		const unsigned char* m_at;
+		const unsigned char* m_end;
+
+	}; // class PathKeys::Utf8Cursor
+
+	class Utf16Cursor
+	{
+	public:
+		Utf16Cursor(const char16_t* text, std::size_t size)
+			: m_at(text), m_end(text + size)
+		{
+		}
+
+		bool next(char32_t& codePoint)
+		{
+			if (m_at == m_end) return false;
+
+			char32_t unit = *m_at++;
+
+			if (unit >= 0xD800 && unit <= 0xDBFF && m_at != m_end
+				&& *m_at >= 0xDC00 && *m_at <= 0xDFFF)
+				unit = 0x10000 + ((unit - 0xD800) << 10) + (*m_at++ - 0xDC00);
+
+			codePoint = unit;
+			return true;
+		}
+
+	private:
+		const char16_t* m_at;
+		const char16_t* m_end;
+
+	}; // class PathKeys::Utf16Cursor
+
+	inline Utf8Cursor cursor(std::string_view key) { return Utf8Cursor(key); }
+	inline Utf8Cursor cursor(const char* key) { return Utf8Cursor(key); }
+	inline Utf8Cursor cursor(const std::string& key) { return Utf8Cursor(key); }
+
+	inline Utf16Cursor cursor(QStringView key)
+	{
+		return Utf16Cursor(key.utf16(), static_cast<std::size_t>(key.size()));
+	}
+
+	inline Utf16Cursor cursor(const QString& key)
+	{
+		return cursor(QStringView(key));
+	}
+
+	// Native strings are UTF-8 on POSIX and UTF-16 on Windows
+	template <typename CharT>
+	auto nativeCursor(const std::basic_string<CharT>& native)
+	{
+		if constexpr (std::is_same_v<CharT, char>)
+			return Utf8Cursor(native);
+		else
+		{
+			static_assert(sizeof(CharT) == sizeof(char16_t));
+
+			return Utf16Cursor
+			(
+				reinterpret_cast<const char16_t*>(native.data()),
+				native.size()
+			);
+		}
+	}
+
+	inline auto cursor(const Path& key) { return nativeCursor(key.native()); }
+
+	/// @brief FNV-1a over code points. Never returns 0, which the tables use
+	/// to mark empty slots
+	template <typename KeyT>
+	std::size_t hash(const KeyT& key)
+	{
+		auto at = cursor(key);
+		std::uint64_t hash = 0xcbf29ce484222325ull;
+		char32_t code_point{};
+
+		while (at.next(code_point))
+		{
+			hash ^= code_point;
+			hash *= 0x100000001b3ull;
+		}
+
+		auto result = static_cast<std::size_t>(hash ^ (hash >> 32));
+		return result ? result : 1;
+	}
+
+	template <typename KeyT>
+	bool equals(const Path& path, const KeyT& key)
+	{
+		auto a = cursor(path);
+		auto b = cursor(key);
+		char32_t x{}, y{};
+
+		while (true)
+		{
+			auto has_x = a.next(x);
+			auto has_y = b.next(y);
+
+			if (has_x != has_y) return false;
+			if (!has_x) return true;
+			if (x != y) return false;
+		}
+	}
+
+} // namespace PathKeys
+
+/// @brief Open-addressing (linear probing) table behind PathSet and PathMap.
+/// Each slot keeps its entry's hash, so growing never rehashes a key, and
+/// probes compare hashes before text
+template <typename EntryT>
+class BasicPathTable
+{
+public:
+	class Iterator
+	{
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = EntryT;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const EntryT*;
+		using reference = const EntryT&;
+
+		Iterator() = default;
+		Iterator(const BasicPathTable* table, std::size_t index)
+			: m_table(table), m_index(index)
+		{
+			_skipEmpty();
+		}
+
+		reference operator*() const { return *m_table->m_slots[m_index].entry; }
+		pointer operator->() const { return &**this; }
+
+		Iterator& operator++()
+		{
+			++m_index;
+			_skipEmpty();
+
+			return *this;
+		}
+
+		Iterator operator++(int)
+		{
+			auto copy = *this;
+			++*this;
+
+			return copy;
+		}
+
+		bool operator==(const Iterator& other) const = default;
+
+	private:
+		const BasicPathTable* m_table = nullptr;
+		std::size_t m_index = 0;
+
+		void _skipEmpty()
+		{
+			auto& entries = m_table->m_slots;
+
+			while (m_index < entries.size() && entries[m_index].hash == 0)
+				++m_index;
+		}
+
+	}; // class BasicPathTable::Iterator
+
+	Iterator begin() const { return Iterator(this, 0); }
+	Iterator end() const { return Iterator(this, m_slots.size()); }
+
+	qsizetype size() const { return static_cast<qsizetype>(m_size); }
+	bool isEmpty() const { return m_size == 0; }
+
+	void clear()
+	{
+		m_slots.clear();
+		m_size = 0;
+	}
+
+	void reserve(qsizetype count)
+	{
+		auto needed = _capacityFor(static_cast<std::size_t>(count));
+		if (needed > m_slots.size()) _rehash(needed);
+	}
+
+	template <typename KeyT>
+	bool contains(const KeyT& key) const
+	{
+		return _find(key, PathKeys::hash(key)) != NOT_FOUND;
+	}
+
+	template <typename KeyT>
+	bool remove(const KeyT& key)
+	{
+		auto index = _find(key, PathKeys::hash(key));
+		if (index == NOT_FOUND) return false;
+
+		_erase(index);
+		return true;
+	}
+
+protected:
+	constexpr static auto NOT_FOUND = static_cast<std::size_t>(-1);
+
+	struct Slot
+	{
+		std::size_t hash = 0; // 0 = empty
+		std::optional<EntryT> entry{};
+	};
+
+	std::vector<Slot> m_slots{};
+	std::size_t m_size = 0;
+
+	static const Path& _keyOf(const EntryT& entry)
+	{
+		if constexpr (std::is_same_v<EntryT, Path>)
+			return entry;
+		else
+			return entry.first;
+	}
+
+	template <typename KeyT>
+	std::size_t _find(const KeyT& key, std::size_t hash) const
+	{
+		if (m_slots.empty()) return NOT_FOUND;
+
+		auto mask = m_slots.size() - 1;
+
+		for (auto i = hash & mask; m_slots[i].hash != 0; i = (i + 1) & mask)
+		{
+			auto& slot = m_slots[i];
+
+			if (slot.hash == hash && PathKeys::equals(_keyOf(*slot.entry), key))
+				return i;
+		}
+
+		return NOT_FOUND;
+	}
+
+	/// @brief Places an entry whose key isn't present yet
+	std::size_t _insert(std::size_t hash, EntryT&& entry)
+	{
+		if ((m_size + 1) * 4 > m_slots.size() * 3)
+			_rehash(_capacityFor(m_size + 1));
+
+		auto mask = m_slots.size() - 1;
+		auto i = hash & mask;
+
+		while (m_slots[i].hash != 0)
+			i = (i + 1) & mask;
+
+		m_slots[i].hash = hash;
+		m_slots[i].entry.emplace(std::move(entry));
+		++m_size;
+
+		return i;
+	}
+
+	/// @brief Backward-shift deletion, so probing never needs tombstones
+	void _erase(std::size_t index)
+	{
+		auto mask = m_slots.size() - 1;
+		auto hole = index;
+
+		for (auto i = (hole + 1) & mask; m_slots[i].hash != 0; i = (i + 1) & mask)
+		{
+			auto home = m_slots[i].hash & mask;
+
+			// Move back only if the hole lies on the entry's probe path
+			auto distance_to_i = (i - home) & mask;
+			auto distance_to_hole = (hole - home) & mask;
+			if (distance_to_hole > distance_to_i) continue;
+
+			m_slots[hole].hash = m_slots[i].hash;
+			m_slots[hole].entry.emplace(std::move(*m_slots[i].entry));
+			hole = i;
+		}
+
+		m_slots[hole].hash = 0;
+		m_slots[hole].entry.reset();
+		--m_size;
+	}
+
+	static std::size_t _capacityFor(std::size_t count)
+	{
+		std::size_t capacity = 16;
+
+		while (count * 4 > capacity * 3)
+			capacity *= 2;
+
+		return capacity;
+	}
+
+	void _rehash(std::size_t capacity)
+	{
+		std::vector<Slot> old(capacity);
+		old.swap(m_slots);
+
+		auto mask = capacity - 1;
+
+		for (auto& slot : old)
+		{
+			if (slot.hash == 0) continue;
+
+			auto i = slot.hash & mask;
+
+			while (m_slots[i].hash != 0)
+				i = (i + 1) & mask;
+
+			m_slots[i].hash = slot.hash;
+			m_slots[i].entry.emplace(std::move(*slot.entry));
+		}
+	}
+
+}; // class BasicPathTable
+
+/// @brief A set of Paths that can also be queried by QString,
+/// QStringView, std::string_view, or const char* without building a Path
+class PathSet : public BasicPathTable<Path>
+{
+public:
+	PathSet() = default;
+
+	PathSet(std::initializer_list<Path> paths)
+	{
+		reserve(static_cast<qsizetype>(paths.size()));
+
+		for (auto& path : paths)
+			insert(path);
+	}
+
+	/// @brief Returns false if the path was already present
+	bool insert(const Path& path)
+	{
+		auto hash = PathKeys::hash(path);
+		if (_find(path, hash) != NOT_FOUND) return false;
+
+		_insert(hash, Path(path));
+		return true;
+	}
+
+}; // class PathSet
+
+/// @brief A Path-keyed map that can also be queried by QString,
+/// QStringView, std::string_view, or const char* without building a Path
+template <typename T>
+class PathMap : public BasicPathTable<std::pair<const Path, T>>
+{
+	using Base = BasicPathTable<std::pair<const Path, T>>;
+
+public:
+	/// @brief Inserts or overwrites, like QHash::insert
+	void insert(const Path& path, T value)
+	{
+		auto hash = PathKeys::hash(path);
+		auto index = this->_find(path, hash);
+
+		if (index != Base::NOT_FOUND)
+			this->m_slots[index].entry->second = std::move(value);
+		else
+			this->_insert(hash, { path, std::move(value) });
+	}
+
+	/// @brief Returns the value for path, default-inserting it if missing
+	T& operator[](const Path& path)
+	{
+		auto hash = PathKeys::hash(path);
+		auto index = this->_find(path, hash);
+
+		if (index == Base::NOT_FOUND)
+			index = this->_insert(hash, { path, T{} });
+
+		return this->m_slots[index].entry->second;
+	}
+
+	/// @brief Returns a pointer to the value, or nullptr if key is missing
+	template <typename KeyT>
+	T* find(const KeyT& key)
+	{
+		auto index = this->_find(key, PathKeys::hash(key));
+		if (index == Base::NOT_FOUND) return nullptr;
+
+		return &this->m_slots[index].entry->second;
+	}
+
+	template <typename KeyT>
+	const T* find(const KeyT& key) const
+	{
+		return const_cast<PathMap*>(this)->find(key);
+	}
+
+	template <typename KeyT>
+	T value(const KeyT& key, const T& defaultValue = T{}) const
+	{
+		auto found = find(key);
+		return found ? *found : defaultValue;
+	}
+
+}; // class PathMap
@@ -0,0 +1,584 @@
+#pragma once
+
+/*
+* cc/PathSnapshot.hpp  Copyright (C) 2026  fairybow
+*
+* You should have received a copy of the GNU General Public License along with
+* this program. If not, see <https://www.gnu.org/licenses/>.
+*
+* This file uses Qt 6. Qt is a free and open-source widget toolkit for creating
+* graphical user interfaces. For more information, visit <https://www.qt.io/>.
+*
+* Updated: 2026-10-16
+*/
+
+#include "Path.hpp"
+#include "PathFileOps.hpp"
+#include "PathWorkers.hpp"
+
+#include <QIODevice>
+#include <QList>
+#include <QSaveFile>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/// @brief The entries under a directory, with sizes and mtimes, in a compact
+/// binary form that's saved once and later memory-mapped, so a restarted
+/// service can ask what changed instead of rescanning everything
+/// @details The file is a header, then fixed-size records in breadth-first
+/// order (so each folder's children are one contiguous run), then the names.
+/// Loading validates the layout and reads the records in place. The format
+/// uses native byte order; it's a cache, not an interchange format
+///
+/// Symlinks aren't followed: a link is an entry with the link's own metadata
+class PathSnapshot
+{
+public:
+	enum class TrustFolderMtime { No = 0, Yes };
+
+	struct Diff
+	{
+		QList<Path> added{};
+		QList<Path> removed{};
+		QList<Path> modified{};
+
+		bool isEmpty() const
+		{
+			return added.isEmpty() && removed.isEmpty() && modified.isEmpty();
+		}
+	};
+
+	PathSnapshot() = default;
+
+	/// @brief Scans the tree under root across a thread pool
+	static PathSnapshot take(const Path& root, int threadCount = 0)
+	{
+		PathSnapshot snapshot{};
+
+		PathFileOps::Entry entry{};
+		if (!PathFileOps::stat(root.toStd(), entry) || !entry.isFolder)
+			return snapshot;
+
+		struct Child
+		{
+			std::string name{};
+			bool isFolder = false;
+			std::uint64_t size = 0;
+			std::int64_t mtime = 0;
+			std::size_t listing = 0;
+		};
+
+		using Listing = std::vector<Child>;
+		using Job = std::pair<std::size_t, std::filesystem::path>;
+
+		std::vector<std::vector<std::pair<std::size_t, Listing>>> results
+		(
+			PathWorkers::count(threadCount)
+		);
+
+		std::atomic<std::size_t> next_listing{ 1 };
+
+		PathWorkers::run<Job>
+		(
+			{ { 0, root.toStd() } },
+			[&](int worker, Job job, auto push)
+			{
+				Listing listing{};
+
+				PathFileOps::list
+				(
+					job.second,
+					[&](const PathFileOps::Entry& entry)
+					{
+						Child child
+						{
+							entry.path.filename().string(),
+							entry.isFolder,
+							entry.size,
+							entry.mtime,
+							0
+						};
+
+						if (child.isFolder)
+						{
+							child.listing = next_listing.fetch_add(1);
+							push({ child.listing, entry.path });
+						}
+
+						listing.push_back(std::move(child));
+					}
+				);
+
+				results[worker].emplace_back(job.first, std::move(listing));
+			},
+			threadCount
+		);
+
+		std::vector<Listing> listings(next_listing.load());
+
+		for (auto& result : results)
+			for (auto& [id, listing] : result)
+				listings[id] = std::move(listing);
+
+		// Breadth-first, so each folder's children land next to each other
+		auto& records = snapshot.m_ownedRecords;
+		auto& names = snapshot.m_ownedNames;
+		std::vector<std::size_t> listing_of{ 0 };
+
+		records.push_back({ entry.size, entry.mtime, 0, 0, 0, 0, 1, 0 });
+
+		for (std::size_t i = 0; i < records.size(); ++i)
+		{
+			if (!records[i].isFolder) continue;
+
+			auto& children = listings[listing_of[i]];
+
+			std::sort
+			(
+				children.begin(),
+				children.end(),
+				[](const Child& a, const Child& b) { return a.name < b.name; }
+			);
+
+			records[i].firstChild = static_cast<std::uint32_t>(records.size());
+			records[i].childCount = static_cast<std::uint32_t>(children.size());
+
+			for (auto& child : children)
+			{
+				records.push_back
+				({
+					child.size,
+					child.mtime,
+					static_cast<std::uint32_t>(names.size()),
+					static_cast<std::uint32_t>(child.name.size()),
+					0,
+					0,
+					child.isFolder,
+					0
+				});
+
+				names.insert(names.end(), child.name.begin(), child.name.end());
+				listing_of.push_back(child.listing);
+			}
+		}
+
+		return snapshot;
+	}
+
+	/// @brief Loads a saved snapshot by mapping it. Returns nothing if the
+	/// file is missing or isn't a valid snapshot
+	static std::optional<PathSnapshot> load(const Path& file)
+	{
+		auto mapping = file.map(Path::Access::Random);
+		if (!mapping || mapping.size() < sizeof(Header)) return {};
+
+		Header header{};
+		std::memcpy(&header, mapping.data(), sizeof(Header));
+
+		if (std::memcmp(header.magic, MAGIC, sizeof(header.magic)) != 0
+			|| header.version != VERSION)
+			return {};
+
+		auto records_size = header.recordCount * sizeof(Record);
+
+		if (header.recordCount == 0
+			|| header.recordCount > UINT32_MAX
+			|| mapping.size() != sizeof(Header) + records_size + header.namesSize)
+			return {};
+
+		PathSnapshot snapshot{};
+		snapshot.m_mapping = std::move(mapping);
+		snapshot.m_count = static_cast<std::size_t>(header.recordCount);
+		snapshot.m_namesSize = static_cast<std::size_t>(header.namesSize);
+
+		if (!snapshot._isValid()) return {};
+
+		return snapshot;
+	}
+
+	/// @brief Writes the snapshot atomically (readers see the old file or the
+	/// new one, never half of one)
+	bool save(const Path& file) const
+	{
+		if (isEmpty()) return false;
+
+		Header header{};
+		std::memcpy(header.magic, MAGIC, sizeof(header.magic));
+		header.version = VERSION;
+		header.recordCount = _count();
+		header.namesSize = _namesSize();
+
+		QSaveFile out(file.toQString());
+		if (!out.open(QIODevice::WriteOnly)) return false;
+
+		auto write = [&](const void* data, std::size_t size)
+			{
+				return out.write
+				(
+					static_cast<const char*>(data),
+					static_cast<qint64>(size)
+				) == static_cast<qint64>(size);
+			};
+
+		if (!write(&header, sizeof(Header))
+			|| !write(_records(), _count() * sizeof(Record))
+			|| !write(_names(), _namesSize()))
+		{
+			out.cancelWriting();
+			return false;
+		}
+
+		return out.commit();
+	}
+
+	bool isEmpty() const { return _count() == 0; }
+
+	/// @brief Entries under the root (files, folders, and links)
+	qsizetype size() const
+	{
+		return isEmpty() ? 0 : static_cast<qsizetype>(_count() - 1);
+	}
+
+	/// @brief Compares the snapshot with the tree now under root
+	/// @details A folder whose mtime hasn't changed has the same entries, so
+	/// it isn't listed again; its entries are statted individually instead.
+	/// TrustFolderMtime::Yes goes further and doesn't stat files in such a
+	/// folder either (only subfolders), which is much faster but misses files
+	/// edited in place, since that doesn't touch the folder's mtime
+	Diff diff
+	(
+		const Path& root,
+		TrustFolderMtime trust = TrustFolderMtime::No,
+		int threadCount = 0
+	)
+		const
+	{
+		Diff diff{};
+		if (isEmpty()) return diff;
+
+		auto workers = PathWorkers::count(threadCount);
+		std::vector<Changes> changes(workers);
+
+		PathFileOps::Entry live{};
+		auto root_path = root.toStd();
+
+		if (!PathFileOps::stat(root_path, live) || !live.isFolder)
+		{
+			_removed(0, root_path, changes[0], false);
+			return _collect(changes);
+		}
+
+		PathWorkers::run<Job>
+		(
+			{ { 0, root_path, live.mtime, false } },
+			[&](int worker, Job job, auto push)
+			{
+				if (job.added)
+					_added(job.path, changes[worker], push);
+				else
+					_compare(job, trust, changes[worker], push);
+			},
+			threadCount
+		);
+
+		return _collect(changes);
+	}
+
+private:
+	constexpr static char MAGIC[4] = { 'C', 'C', 'P', 'S' };
+	constexpr static std::uint32_t VERSION = 1;
+
+	struct Header
+	{
+		char magic[4];
+		std::uint32_t version;
+		std::uint64_t recordCount;
+		std::uint64_t namesSize;
+	};
+
+	struct Record
+	{
+		std::uint64_t size;
+		std::int64_t mtime;
+		std::uint32_t nameOffset;
+		std::uint32_t nameLength;
+		std::uint32_t firstChild;
+		std::uint32_t childCount;
+		std::uint32_t isFolder;
+		std::uint32_t reserved;
+	};
+
+	static_assert(sizeof(Header) == 24, "Header layout must not change");
+	static_assert(sizeof(Record) == 40, "Record layout must not change");
+
+	struct Job
+	{
+		std::uint32_t record = 0;
+		std::filesystem::path path{};
+		std::int64_t mtime = 0; // Live mtime of the folder at path
+		bool added = false; // A folder not in the snapshot at all
+	};
+
+	struct Changes
+	{
+		std::vector<std::filesystem::path> added{};
+		std::vector<std::filesystem::path> removed{};
+		std::vector<std::filesystem::path> modified{};
+	};
+
+	std::vector<Record> m_ownedRecords{};
+	std::vector<char> m_ownedNames{};
+
+	Path::Mapping m_mapping{};
+	std::size_t m_count = 0;
+	std::size_t m_namesSize = 0;
+
+	// A snapshot is either built (owned vectors) or loaded (mapping)
+
+	const Record* _records() const
+	{
+		if (!m_mapping) return m_ownedRecords.data();
+
+		return reinterpret_cast<const Record*>
+		(
+			m_mapping.data() + sizeof(Header)
+		);
+	}
+
+	const char* _names() const
+	{
+		if (!m_mapping) return m_ownedNames.data();
+
+		return reinterpret_cast<const char*>
+		(
+			m_mapping.data() + sizeof(Header) + m_count * sizeof(Record)
+		);
+	}
+
+	std::size_t _count() const
+	{
+		return m_mapping ? m_count : m_ownedRecords.size();
+	}
+
+	std::size_t _namesSize() const
+	{
+		return m_mapping ? m_namesSize : m_ownedNames.size();
+	}
+
+	std::string_view _name(const Record& record) const
+	{
+		return { _names() + record.nameOffset, record.nameLength };
+	}
+
+	/// @brief Checks a loaded file's records against its own sizes, so a
+	/// corrupt snapshot can't send lookups out of bounds
+	bool _isValid() const
+	{
+		auto records = _records();
+		if (!records[0].isFolder) return false;
+
+		for (std::size_t i = 0; i < m_count; ++i)
+		{
+			auto& record = records[i];
+
+			if (std::uint64_t(record.nameOffset) + record.nameLength
+				> m_namesSize)
+				return false;
+
+			if (record.childCount == 0) continue;
+
+			// Children always follow their parent, so there are no cycles
+			if (!record.isFolder
+				|| record.firstChild <= i
+				|| std::uint64_t(record.firstChild) + record.childCount
+					> m_count)
+				return false;
+		}
+
+		return true;
+	}
+
+	template <typename PushT>
+	void _compare
+	(
+		const Job& job,
+		TrustFolderMtime trust,
+		Changes& changes,
+		PushT& push
+	)
+		const
+	{
+		auto records = _records();
+		auto& folder = records[job.record];
+		auto first = folder.firstChild;
+		auto last = first + folder.childCount;
+
+		if (job.mtime == folder.mtime)
+		{
+			// Same listing: check each known entry where it was
+			for (auto i = first; i < last; ++i)
+			{
+				auto& record = records[i];
+				auto path = job.path / _name(record);
+
+				if (!record.isFolder && trust == TrustFolderMtime::Yes)
+					continue;
+
+				PathFileOps::Entry live{};
+
+				if (!PathFileOps::stat(path, live))
+					_removed(i, path, changes, true);
+				else
+					_match(i, live, changes, push);
+			}
+
+			return;
+		}
+
+		std::unordered_map<std::string_view, std::uint32_t> known{};
+		known.reserve(folder.childCount);
+
+		for (auto i = first; i < last; ++i)
+			known.emplace(_name(records[i]), i);
+
+		std::vector<char> seen(folder.childCount, 0);
+
+		PathFileOps::list
+		(
+			job.path,
+			[&](const PathFileOps::Entry& live)
+			{
+				auto name = live.path.filename().string();
+				auto it = known.find(name);
+
+				if (it == known.end())
+				{
+					_addedEntry(live, changes, push);
+					return;
+				}
+
+				seen[it->second - first] = 1;
+				_match(it->second, live, changes, push);
+			}
+		);
+
+		for (auto i = first; i < last; ++i)
+			if (!seen[i - first])
+				_removed(i, job.path / _name(records[i]), changes, true);
+	}
+
+	/// @brief Compares a live entry with the record at the same path
+	template <typename PushT>
+	void _match
+	(
+		std::uint32_t index,
+		const PathFileOps::Entry& live,
+		Changes& changes,
+		PushT& push
+	)
+		const
+	{
+		auto& record = _records()[index];
+
+		if (bool(record.isFolder) != live.isFolder)
+		{
+			_removed(index, live.path, changes, true);
+			_addedEntry(live, changes, push);
+		}
+		else if (live.isFolder)
+			push({ index, live.path, live.mtime, false });
+		else if (live.size != record.size || live.mtime != record.mtime)
+			changes.modified.push_back(live.path);
+	}
+
+	template <typename PushT>
+	static void _addedEntry
+	(
+		const PathFileOps::Entry& live,
+		Changes& changes,
+		PushT& push
+	)
+	{
+		changes.added.push_back(live.path);
+
+		if (live.isFolder)
+			push({ 0, live.path, live.mtime, true });
+	}
+
+	/// @brief Everything under a folder that's new since the snapshot
+	template <typename PushT>
+	static void _added
+	(
+		const std::filesystem::path& folder,
+		Changes& changes,
+		PushT& push
+	)
+	{
+		PathFileOps::list
+		(
+			folder,
+			[&](const PathFileOps::Entry& live)
+			{
+				_addedEntry(live, changes, push);
+			}
+		);
+	}
+
+	/// @brief Reports a record (if asked) and everything under it as removed
+	void _removed
+	(
+		std::uint32_t index,
+		const std::filesystem::path& path,
+		Changes& changes,
+		bool includeSelf
+	)
+		const
+	{
+		auto& record = _records()[index];
+		if (includeSelf) changes.removed.push_back(path);
+
+		for (auto i = record.firstChild;
+			i < record.firstChild + record.childCount; ++i)
+			_removed(i, path / _name(_records()[i]), changes, true);
+	}
+
+	static Diff _collect(std::vector<Changes>& changes)
+	{
+		Diff diff{};
+
+		auto gather = [&](QList<Path>& out, auto member)
+			{
+				for (auto& change : changes)
+					for (auto& path : change.*member)
+						out << Path(std::move(path));
+
+				std::sort
+				(
+					out.begin(),
+					out.end(),
+					[](const Path& a, const Path& b)
+					{
+						return a.native() < b.native();
+					}
+				);
+			};
+
+		gather(diff.added, &Changes::added);
+		gather(diff.removed, &Changes::removed);
+		gather(diff.modified, &Changes::modified);
+
+		return diff;
+	}
+
+}; // class PathSnapshot
@@ -0,0 +1,305 @@
+#pragma once
+
+/*
+* cc/PathTree.hpp  Copyright (C) 2026  fairybow
+*
+* You should have received a copy of the GNU General Public License along with
+* this program. If not, see <https://www.gnu.org/licenses/>.
+*
+* This file uses Qt 6. Qt is a free and open-source widget toolkit for creating
+* graphical user interfaces. For more information, visit <https://www.qt.io/>.
+*
+* Updated: 2026-10-16
+*/
+
+#include "Path.hpp"
+
+#include <QList>
+
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/// @brief A set of Paths stored as a tree of components, so paths sharing a
+/// prefix share its nodes. Insert, lookup, and subtree counts are O(depth);
+/// listing a subtree only visits that subtree
+/// @details Paths are split on separators and empty components are skipped,
+/// so "a//b" and "a/b/" are the same entry as "a/b". A leading separator
+/// (absolute path) is its own first component
+class PathTree
+{
+public:
+	PathTree() = default;
+
+	explicit PathTree(const QList<Path>& paths)
+	{
+		for (auto& path : paths)
+			insert(path);
+	}
+
+	PathTree(const PathTree&) = delete;
+	PathTree& operator=(const PathTree&) = delete;
+	// Not defaulted: a moved-from tree is left empty, as clear() leaves it,
+	// rather than with no root
+	PathTree(PathTree&& other)
+		: m_root(std::exchange(other.m_root, std::make_unique<Node>()))
+	{
+	}
+
+	PathTree& operator=(PathTree&& other)
+	{
+		if (this != &other)
+			m_root = std::exchange(other.m_root, std::make_unique<Node>());
+
+		return *this;
+	}
+
+	qsizetype size() const { return m_root->count; }
+	bool isEmpty() const { return m_root->count == 0; }
+
+	void clear() { m_root = std::make_unique<Node>(); }
+
+	/// @brief Returns false if the path was already present
+	bool insert(const Path& path)
+	{
+		auto node = m_root.get();
+
+		for (auto part : _split(path))
+		{
+			auto it = node->children.find(part);
+
+			if (it == node->children.end())
+			{
+				auto child = std::make_unique<Node>();
+				child->name = string_type(part);
+				child->parent = node;
+
+				it = node->children.emplace(child->name, std::move(child)).first;
+			}
+
+			node = it->second.get();
+		}
+
+		if (node->member) return false;
+
+		node->member = true;
+
+		for (auto up = node; up; up = up->parent)
+			++up->count;
+
+		return true;
+	}
+
+	/// @brief Removes the path (not its descendants), pruning nodes left
+	/// with nothing under them
+	bool remove(const Path& path)
+	{
+		auto node = _find(path);
+		if (!node || !node->member) return false;
+
+		node->member = false;
+
+		for (auto up = node; up; up = up->parent)
+			--up->count;
+
+		while (node->parent && node->count == 0)
+		{
+			auto parent = node->parent;
+			parent->children.erase(parent->children.find(node->name));
+			node = parent;
+		}
+
+		return true;
+	}
+
+	bool contains(const Path& path) const
+	{
+		auto node = _find(path);
+		return node && node->member;
+	}
+
+	/// @brief Counts members at or below root
+	qsizetype countUnder(const Path& root) const
+	{
+		auto node = _find(root);
+		return node ? node->count : 0;
+	}
+
+	/// @brief Calls visitor(path) for each member at or below root
+	template <typename VisitorT>
+	void forEachUnder(const Path& root, VisitorT visitor) const
+	{
+		auto node = _find(root);
+		if (!node || node->count == 0) return;
+
+		auto prefix = _rebuild(node);
+		_visit(node, prefix, visitor);
+	}
+
+	QList<Path> under(const Path& root) const
+	{
+		QList<Path> paths{};
+		paths.reserve(countUnder(root));
+
+		forEachUnder(root, [&](const Path& path) { paths << path; });
+		return paths;
+	}
+
+	/// @brief Returns the deepest member that is path or one of its
+	/// ancestors, or an empty Path if there is none
+	Path nearestAncestor(const Path& path) const
+	{
+		auto node = m_root.get();
+		const Node* nearest = nullptr;
+
+		for (auto part : _split(path))
+		{
+			auto it = node->children.find(part);
+			if (it == node->children.end()) break;
+
+			node = it->second.get();
+			if (node->member) nearest = node;
+		}
+
+		if (!nearest) return {};
+		return Path(std::filesystem::path(_rebuild(nearest)));
+	}
+
+	/// @brief Returns the longest component prefix shared by every member
+	Path commonPrefix() const
+	{
+		auto node = m_root.get();
+
+		while (!node->member && node->children.size() == 1)
+			node = node->children.begin()->second.get();
+
+		return node == m_root.get()
+			? Path{}
+			: Path(std::filesystem::path(_rebuild(node)));
+	}
+
+private:
+	using char_type = std::filesystem::path::value_type;
+	using string_type = std::filesystem::path::string_type;
+	using view_type = std::basic_string_view<char_type>;
+
+	struct NameHash
+	{
+		using is_transparent = void;
+
+		std::size_t operator()(view_type name) const
+		{
+			return std::hash<view_type>{}(name);
+		}
+	};
+
+	struct Node
+	{
+		string_type name{};
+		Node* parent = nullptr;
+		bool member = false;
+		qsizetype count = 0; // Members in this subtree, including this node
+
+		std::unordered_map
+			<
+			string_type,
+			std::unique_ptr<Node>,
+			NameHash,
+			std::equal_to<>
+			> children{};
+	};
+
+	std::unique_ptr<Node> m_root = std::make_unique<Node>();
+
+	static std::vector<view_type> _split(const Path& path)
+	{
+		view_type native = path.native();
+		std::vector<view_type> parts{};
+		std::size_t start = 0;
+
+		if (!native.empty() && Path::isSeparator(native.front()))
+		{
+			parts.push_back(native.substr(0, 1));
+			start = 1;
+		}
+
+		for (auto i = start; i <= native.size(); ++i)
+		{
+			if (i < native.size() && !Path::isSeparator(native[i])) continue;
+
+			if (i > start)
+				parts.push_back(native.substr(start, i - start));
+
+			start = i + 1;
+		}
+
+		return parts;
+	}
+
+	const Node* _find(const Path& path) const
+	{
+		const Node* node = m_root.get();
+
+		for (auto part : _split(path))
+		{
+			auto it = node->children.find(part);
+			if (it == node->children.end()) return nullptr;
+
+			node = it->second.get();
+		}
+
+		return node;
+	}
+
+	Node* _find(const Path& path)
+	{
+		return const_cast<Node*>(std::as_const(*this)._find(path));
+	}
+
+	static void _join(string_type& prefix, const string_type& name)
+	{
+		if (!prefix.empty() && !Path::isSeparator(prefix.back()))
+			prefix += std::filesystem::path::preferred_separator;
+
+		prefix += name;
+	}
+
+	static string_type _rebuild(const Node* node)
+	{
+		std::vector<const Node*> chain{};
+
+		for (; node && node->parent; node = node->parent)
+			chain.push_back(node);
+
+		string_type path{};
+
+		for (auto it = chain.rbegin(); it != chain.rend(); ++it)
+			_join(path, (*it)->name);
+
+		return path;
+	}
+
+	template <typename VisitorT>
+	static void _visit(const Node* node, string_type& path, VisitorT& visitor)
+	{
+		if (node->member)
+			visitor(Path(std::filesystem::path(path)));
+
+		for (auto& [name, child] : node->children)
+		{
+			if (child->count == 0) continue;
+
+			auto length = path.size();
+			_join(path, name);
+			_visit(child.get(), path, visitor);
+			path.resize(length);
+		}
+	}
+
+}; // class PathTree
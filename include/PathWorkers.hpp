@@ -0,0 +1,412 @@
+#pragma once
+
+/*
+* cc/PathWorkers.hpp  Copyright (C) 2026  fairybow
+*
+* You should have received a copy of the GNU General Public License along with
+* this program. If not, see <https://www.gnu.org/licenses/>.
+*
+* Updated: 2026-10-16
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/// @brief A small work-stealing pool for Path's parallel operations. Each
+/// worker owns a queue: it pops its own work newest-first (keeping a subtree
+/// warm) and, when empty, steals the oldest work from the others (which tends
+/// to be the biggest remaining chunk)
+/// @details Threads are started on first use and kept for the life of the
+/// process; a worker with nothing to do sleeps rather than spinning. The pool
+/// never grows past the hardware threads: a larger threadCount is accepted,
+/// but no more workers than that run at once
+namespace PathWorkers
+{
+	namespace Detail
+	{
+		/// @brief The process-wide threads behind run() and forEach()
+		class Pool
+		{
+		public:
+			static Pool& instance()
+			{
+				static Pool pool{};
+				return pool;
+			}
+
+			~Pool()
+			{
+				{
+					std::lock_guard lock(m_mutex);
+					m_stopping = true;
+				}
+
+				m_wake.notify_all();
+
+				for (auto& thread : m_threads)
+					thread.join();
+			}
+
+			/// @brief Calls job(0) on this thread and job(1) through
+			/// job(helpers) on pool threads, returning once all have returned.
+			/// Helpers that haven't started by the time job(0) returns are
+			/// dropped, so a call made from inside a job (or while the pool is
+			/// busy) can't wait on itself. job mustn't throw
+			/// @details Threads are only added up to one fewer than the
+			/// hardware threads (the caller is the other), so a single large
+			/// request can't leave the process holding idle threads for good
+			void dispatch(int helpers, const std::function<void(int)>& job)
+			{
+				if (helpers <= 0)
+				{
+					job(0);
+					return;
+				}
+
+				Batch batch{ &job };
+				auto threads = std::min(helpers, _limit());
+
+				{
+					std::lock_guard lock(m_mutex);
+
+					while (m_threads.size() < static_cast<std::size_t>(threads))
+						m_threads.emplace_back([this] { _loop(); });
+
+					for (auto i = 1; i <= helpers; ++i)
+						m_tasks.push_back({ &batch, i });
+				}
+
+				m_wake.notify_all();
+				job(0);
+
+				std::unique_lock lock(m_mutex);
+
+				std::erase_if
+				(
+					m_tasks,
+					[&](const Task& task) { return task.batch == &batch; }
+				);
+
+				m_done.wait(lock, [&] { return batch.running == 0; });
+			}
+
+		private:
+			struct Batch
+			{
+				const std::function<void(int)>* job;
+				int running = 0; // Guarded by m_mutex
+			};
+
+			struct Task
+			{
+				Batch* batch;
+				int worker;
+			};
+
+			std::mutex m_mutex{};
+			std::condition_variable m_wake{};
+			std::condition_variable m_done{};
+			std::deque<Task> m_tasks{};
+			std::vector<std::thread> m_threads{};
+			bool m_stopping = false;
+
+			Pool() = default;
+
+			static int _limit()
+			{
+				auto hardware = int(std::thread::hardware_concurrency());
+				return std::max(hardware - 1, 1);
+			}
+
+			void _loop()
+			{
+				std::unique_lock lock(m_mutex);
+
+				while (true)
+				{
+					m_wake.wait
+					(
+						lock,
+						[&] { return m_stopping || !m_tasks.empty(); }
+					);
+
+					if (m_stopping) return;
+
+					auto task = m_tasks.front();
+					m_tasks.pop_front();
+					++task.batch->running;
+
+					lock.unlock();
+					(*task.batch->job)(task.worker);
+					lock.lock();
+
+					if (--task.batch->running == 0)
+						m_done.notify_all();
+				}
+			}
+
+		}; // class PathWorkers::Detail::Pool
+
+	} // namespace PathWorkers::Detail
+
+	/// @brief forEach's default number of indexes handed out at a time
+	constexpr std::size_t BATCH_SIZE = 16;
+
+	/// @brief Fewer batches than this aren't worth waking other workers for
+	/// (see threadsFor). Counting batches rather than items lets one rule
+	/// serve cheap items (a stat, batched) and costly ones (a whole file,
+	/// one per batch)
+	constexpr std::size_t PARALLEL_THRESHOLD = 16;
+
+	/// @brief Resolves a requested worker count (0 = one per hardware thread)
+	inline int count(int requested = 0)
+	{
+		if (requested > 0) return requested;
+
+		auto hardware = static_cast<int>(std::thread::hardware_concurrency());
+		return hardware > 0 ? hardware : 1;
+	}
+
+	/// @brief Runs task on every seed and on anything the task pushes, until
+	/// no work remains. The task is called as task(worker, item, push), where
+	/// worker is in [0, count(threadCount)) and push(item) queues more work on
+	/// the calling worker. The first exception thrown by a task is rethrown
+	/// here once all workers have stopped
+	template <typename ItemT, typename TaskT>
+	void run(std::vector<ItemT> seeds, TaskT task, int threadCount = 0)
+	{
+		if (seeds.empty()) return;
+
+		struct Queue
+		{
+			std::mutex mutex{};
+			std::deque<ItemT> items{};
+		};
+
+		auto workers = count(threadCount);
+		std::vector<Queue> queues(workers);
+		std::atomic<std::size_t> pending{ seeds.size() };
+		std::atomic<std::size_t> queued{ seeds.size() };
+		std::atomic<bool> failed{ false };
+		std::exception_ptr error{};
+		std::mutex error_mutex{};
+
+		// Idle workers sleep here until work is queued or none remains
+		std::mutex idle_mutex{};
+		std::condition_variable idle{};
+
+		for (std::size_t i = 0; i < seeds.size(); ++i)
+			queues[i % workers].items.push_back(std::move(seeds[i]));
+
+		auto take = [&](int worker, ItemT& item)
+			{
+				{
+					std::lock_guard lock(queues[worker].mutex);
+					auto& own = queues[worker].items;
+
+					if (!own.empty())
+					{
+						item = std::move(own.back());
+						own.pop_back();
+						queued.fetch_sub(1, std::memory_order_relaxed);
+						return true;
+					}
+				}
+
+				for (int i = 1; i < workers; ++i)
+				{
+					auto& victim = queues[(worker + i) % workers];
+					std::lock_guard lock(victim.mutex);
+
+					if (!victim.items.empty())
+					{
+						item = std::move(victim.items.front());
+						victim.items.pop_front();
+						queued.fetch_sub(1, std::memory_order_relaxed);
+						return true;
+					}
+				}
+
+				return false;
+			};
+
+		auto loop = [&](int worker)
+			{
+				auto push = [&](ItemT item)
+					{
+						// Count before queueing so pending never reads zero
+						// while this item is still in flight
+						pending.fetch_add(1, std::memory_order_relaxed);
+
+						{
+							std::lock_guard lock(queues[worker].mutex);
+							queues[worker].items.push_back(std::move(item));
+						}
+
+						queued.fetch_add(1, std::memory_order_release);
+
+						// Taking the lock orders this with a sleeper's check
+						std::lock_guard lock(idle_mutex);
+						idle.notify_one();
+					};
+
+				while (pending.load(std::memory_order_acquire) > 0)
+				{
+					ItemT item{};
+
+					if (!take(worker, item))
+					{
+						std::unique_lock lock(idle_mutex);
+
+						idle.wait
+						(
+							lock,
+							[&]
+							{
+								return queued.load(std::memory_order_acquire) > 0
+									|| pending.load(std::memory_order_acquire) == 0;
+							}
+						);
+
+						continue;
+					}
+
+					if (!failed.load(std::memory_order_relaxed))
+					{
+						try
+						{
+							task(worker, std::move(item), push);
+						}
+						catch (...)
+						{
+							std::lock_guard lock(error_mutex);
+							if (!error) error = std::current_exception();
+							failed.store(true, std::memory_order_relaxed);
+						}
+					}
+
+					if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+					{
+						std::lock_guard lock(idle_mutex);
+						idle.notify_all();
+					}
+				}
+			};
+
+		Detail::Pool::instance().dispatch(workers - 1, loop);
+
+		if (error)
+			std::rethrow_exception(error);
+	}
+
+	/// @brief Calls func(worker, index) for every index in [0, size), handing
+	/// out indexes in batches (small by default, so uneven items balance
+	/// across workers; use 1 for a few large items). Exceptions are handled
+	/// as in run()
+	template <typename FuncT>
+	void forEach
+	(
+		std::size_t size,
+		FuncT func,
+		int threadCount = 0,
+		std::size_t batchSize = BATCH_SIZE
+	)
+	{
+		if (size == 0) return;
+
+		auto batch = std::max<std::size_t>(batchSize, 1);
+		auto batches = (size + batch - 1) / batch;
+		auto workers = static_cast<int>
+		(
+			std::min<std::size_t>(count(threadCount), batches)
+		);
+
+		std::atomic<std::size_t> next{ 0 };
+		std::atomic<bool> failed{ false };
+		std::exception_ptr error{};
+		std::mutex error_mutex{};
+
+		auto loop = [&](int worker)
+			{
+				while (!failed.load(std::memory_order_relaxed))
+				{
+					auto begin = next.fetch_add(batch, std::memory_order_relaxed);
+					if (begin >= size) break;
+
+					auto end = std::min(begin + batch, size);
+
+					try
+					{
+						for (auto i = begin; i < end; ++i)
+							func(worker, i);
+					}
+					catch (...)
+					{
+						std::lock_guard lock(error_mutex);
+						if (!error) error = std::current_exception();
+						failed.store(true, std::memory_order_relaxed);
+					}
+				}
+			};
+
+		Detail::Pool::instance().dispatch(workers - 1, loop);
+
+		if (error)
+			std::rethrow_exception(error);
+	}
+
+	/// @brief Returns threadCount, or 1 if size indexes make fewer than
+	/// PARALLEL_THRESHOLD batches of batchSize
+	inline int threadsFor
+	(
+		std::size_t size,
+		int threadCount = 0,
+		std::size_t batchSize = BATCH_SIZE
+	)
+	{
+		auto batch = std::max<std::size_t>(batchSize, 1);
+		auto batches = (size + batch - 1) / batch;
+
+		return batches < PARALLEL_THRESHOLD ? 1 : threadCount;
+	}
+
+	/// @brief Returns a ListT of size results, where result i is func(i),
+	/// computed as forEach would (on the calling thread if threadsFor says
+	/// so)
+	template <typename ListT, typename FuncT>
+	ListT fill
+	(
+		std::size_t size,
+		FuncT func,
+		int threadCount = 0,
+		std::size_t batchSize = BATCH_SIZE
+	)
+	{
+		ListT results(static_cast<typename ListT::size_type>(size));
+
+		// Workers write through one pointer taken here, since a non-const
+		// accessor on an implicitly shared list (e.g., QList) checks whether
+		// to detach on every call
+		auto out = results.data();
+
+		forEach
+		(
+			size,
+			[&](int, std::size_t i) { out[i] = func(i); },
+			threadsFor(size, threadCount, batchSize),
+			batchSize
+		);
+
+		return results;
+	}
+
+} // namespace PathWorkers